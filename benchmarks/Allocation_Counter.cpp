@@ -0,0 +1,15 @@
+#include "Benchmark_Suite.hpp"
+#include <cstdlib>
+#include <new>
+
+// Count every heap allocation, so the suite can report allocations per operation; the default array forms forward to these.
+// Kept in their own translation unit so the replacements are never inlined into the measured code.
+void* operator new(std::size_t size) {
+    suite::allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (auto* memory = std::malloc(size == 0 ? 1 : size)) { return memory; }
+    throw std::bad_alloc{ };
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
@@ -0,0 +1,113 @@
+#ifndef BENCHMARK_SUITE_HPP
+#define BENCHMARK_SUITE_HPP 1
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// Measurement harness for the benchmark suite: one result per (schema, format, operation), reporting throughput,
+/// heap allocations per operation and p50/p99 latency, printed as a table and optionally written as JSON for comparison across commits.
+/// Latency samples each time a batch of operations sized to last about a microsecond, so timer overhead stays small for fast operations.
+/// </summary>
+namespace suite {
+
+// Incremented by the replaced global operator new of the benchmark executable
+inline std::atomic<std::size_t> allocationCount{ 0 };
+
+struct Options {
+    std::size_t sampleCount{ 10000 };
+    const char* jsonPath{ nullptr };
+    const char* label{ "" };
+    bool suiteOnly{ false };
+};
+
+struct Result {
+    std::string schema;
+    std::string format;
+    std::string operation;
+    std::size_t bytesPerRecord{ 0 };
+    double recordsPerSecond{ 0 };
+    double megabytesPerSecond{ 0 };
+    double allocationsPerOperation{ 0 };
+    double p50Nanoseconds{ 0 };
+    double p99Nanoseconds{ 0 };
+};
+
+inline constexpr double targetSampleNanoseconds = 1000;
+
+template <class OPERATION> double TimeBatch(std::size_t batch, OPERATION& operation) {
+    const auto start = std::chrono::steady_clock::now();
+    for (auto i = std::size_t{ 0 }; i < batch; ++i) { operation(); }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Run 'operation' repeatedly; 'bytesPerRecord' is the size of the text or binary form it produces or consumes
+template <class OPERATION> Result Measure(const char* schema, const char* format, const char* operation, std::size_t bytesPerRecord, const Options& options, OPERATION&& run) {
+    // Warm up while doubling the batch until one batch lasts long enough to time precisely
+    auto batch = std::size_t{ 1 };
+    while (TimeBatch(batch, run) < targetSampleNanoseconds && batch < (std::size_t{ 1 } << 20)) { batch *= 2; }
+
+    auto samples = std::vector<double>(options.sampleCount);
+    const auto allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+    auto total = 0.0;
+    for (auto& sample : samples) {
+        const auto elapsed = TimeBatch(batch, run);
+        total += elapsed;
+        sample = elapsed / static_cast<double>(batch);
+    }
+    const auto allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+    std::sort(samples.begin(), samples.end());
+
+    const auto operations = static_cast<double>(batch * samples.size());
+    auto result = Result{ schema, format, operation, bytesPerRecord };
+    result.recordsPerSecond = operations / (total * 1e-9);
+    result.megabytesPerSecond = result.recordsPerSecond * static_cast<double>(bytesPerRecord) / 1e6;
+    result.allocationsPerOperation = static_cast<double>(allocations) / operations;
+    result.p50Nanoseconds = samples[samples.size() / 2];
+    result.p99Nanoseconds = samples[samples.size() * 99 / 100];
+    return result;
+}
+
+// Measure() for operations on a whole batch of 'recordsPerOperation' records, e.g. columnar encoding: throughput counts records,
+// while allocations and latency remain per batch
+template <class OPERATION> Result MeasureBatch(const char* schema, const char* format, const char* operation, std::size_t recordsPerOperation,
+    std::size_t bytesPerRecord, const Options& options, OPERATION&& run) {
+    auto result = Measure(schema, format, operation, bytesPerRecord, options, run);
+    result.recordsPerSecond *= static_cast<double>(recordsPerOperation);
+    result.megabytesPerSecond *= static_cast<double>(recordsPerOperation);
+    return result;
+}
+
+inline void PrintHeader() {
+    std::printf("%-10s %-7s %-16s %7s %14s %10s %10s %10s %10s\n", "schema", "format", "operation", "bytes", "records/s", "MB/s", "allocs/op", "p50 ns", "p99 ns");
+}
+
+inline void Print(const Result& result) {
+    std::printf("%-10s %-7s %-16s %7zu %14.0f %10.1f %10.2f %10.1f %10.1f\n", result.schema.c_str(), result.format.c_str(), result.operation.c_str(),
+        result.bytesPerRecord, result.recordsPerSecond, result.megabytesPerSecond, result.allocationsPerOperation, result.p50Nanoseconds, result.p99Nanoseconds);
+}
+
+// One JSON document: the run label, then one object per result
+inline bool WriteJson(const char* path, const char* label, const std::vector<Result>& results) {
+    auto* file = std::fopen(path, "w");
+    if (file == nullptr) { return false; }
+    std::fprintf(file, "{\n  \"label\": \"%s\",\n  \"results\": [\n", label);
+    for (auto i = std::size_t{ 0 }; i < results.size(); ++i) {
+        const auto& result = results[i];
+        std::fprintf(file, "    {\"schema\": \"%s\", \"format\": \"%s\", \"operation\": \"%s\", \"bytes_per_record\": %zu, \"records_per_second\": %.1f, "
+            "\"megabytes_per_second\": %.3f, \"allocations_per_operation\": %.3f, \"p50_ns\": %.1f, \"p99_ns\": %.1f}%s\n",
+            result.schema.c_str(), result.format.c_str(), result.operation.c_str(), result.bytesPerRecord, result.recordsPerSecond,
+            result.megabytesPerSecond, result.allocationsPerOperation, result.p50Nanoseconds, result.p99Nanoseconds, i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    return std::fclose(file) == 0;
+}
+
+} // namespace suite
+
+#endif // !BENCHMARK_SUITE_HPP
@@ -0,0 +1,66 @@
+#ifndef SUITE_SCHEMAS_HPP
+#define SUITE_SCHEMAS_HPP 1
+
+#include <optional>
+#include <string_view>
+#include "Foo.hpp"
+
+// Representative record shapes for the benchmark suite, alongside FOO and the generated wide structs
+
+// One field deliberately unmapped, as in the tests
+struct BAR : public SERIALIZATION<BAR>, LEXICOGRAPHICAL_EQUALITY<BAR> {
+    int one_{ 0 };
+    std::string_view two_;
+    std::string_view ignoreMe_;
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&BAR::one_, "one"), MakeBinding(&BAR::two_, "two"));
+    }
+};
+
+// Nested serializable objects
+struct FOO_BAR : public SERIALIZATION<FOO_BAR>, LEXICOGRAPHICAL_EQUALITY<FOO_BAR> {
+    FOO foo_{ };
+    BAR bar_{ };
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&FOO_BAR::foo_, "foo"), MakeBinding(&FOO_BAR::bar_, "bar"));
+    }
+};
+
+// Mostly optional members, about half of them engaged
+struct SPARSE : public SERIALIZATION<SPARSE>, LEXICOGRAPHICAL_EQUALITY<SPARSE> {
+    std::optional<int> id_{ };
+    std::optional<int> parent_{ };
+    std::optional<std::string_view> name_{ };
+    std::optional<std::string_view> alias_{ };
+    std::optional<char> flag_{ };
+    std::optional<FOO> detail_{ };
+    std::optional<BAR> extra_{ };
+    int version_{ 0 };
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&SPARSE::id_, "id"), MakeBinding(&SPARSE::parent_, "parent"), MakeBinding(&SPARSE::name_, "name"),
+            MakeBinding(&SPARSE::alias_, "alias"), MakeBinding(&SPARSE::flag_, "flag"), MakeBinding(&SPARSE::detail_, "detail"),
+            MakeBinding(&SPARSE::extra_, "extra"), MakeBinding(&SPARSE::version_, "version"));
+    }
+};
+
+inline FOO_BAR MakeFooBar() {
+    auto result = FOO_BAR{ };
+    result.foo_ = FOO{ 123456, "a short text field", '-' };
+    result.bar_.one_ = -42;
+    result.bar_.two_ = "another text field";
+    return result;
+}
+
+inline SPARSE MakeSparse() {
+    auto result = SPARSE{ };
+    result.id_ = 987654;
+    result.name_ = "sparse record";
+    result.detail_ = FOO{ 7, "detail", '+' };
+    result.version_ = 3;
+    return result;
+}
+
+#endif // !SUITE_SCHEMAS_HPP
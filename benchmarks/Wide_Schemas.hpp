@@ -0,0 +1,50 @@
+#ifndef WIDE_SCHEMAS_HPP
+#define WIDE_SCHEMAS_HPP 1
+
+#include "Serial_CRTP.hpp"
+
+// Generated wide message types: f000 ... f199, each an int mapped under its own name
+#define WIDE_DIGITS(M, PREFIX) M(PREFIX##0) M(PREFIX##1) M(PREFIX##2) M(PREFIX##3) M(PREFIX##4) M(PREFIX##5) M(PREFIX##6) M(PREFIX##7) M(PREFIX##8) M(PREFIX##9)
+
+#define WIDE_FIELDS_10(M) WIDE_DIGITS(M, 00)
+#define WIDE_FIELDS_50(M) WIDE_FIELDS_10(M) WIDE_DIGITS(M, 01) WIDE_DIGITS(M, 02) WIDE_DIGITS(M, 03) WIDE_DIGITS(M, 04)
+#define WIDE_FIELDS_200(M) WIDE_FIELDS_50(M) \
+    WIDE_DIGITS(M, 05) WIDE_DIGITS(M, 06) WIDE_DIGITS(M, 07) WIDE_DIGITS(M, 08) WIDE_DIGITS(M, 09) \
+    WIDE_DIGITS(M, 10) WIDE_DIGITS(M, 11) WIDE_DIGITS(M, 12) WIDE_DIGITS(M, 13) WIDE_DIGITS(M, 14) \
+    WIDE_DIGITS(M, 15) WIDE_DIGITS(M, 16) WIDE_DIGITS(M, 17) WIDE_DIGITS(M, 18) WIDE_DIGITS(M, 19)
+
+#define WIDE_MEMBER(N) int f##N##_{ 0 };
+#define WIDE_BINDING(N) MakeBinding(&SELF::f##N##_, "f" #N),
+
+// Generated binding lists end in a comma; close them with a placeholder and drop it again
+template <class TUPLE, std::size_t... I>
+constexpr auto DropPlaceholder(const TUPLE& bindings, std::index_sequence<I...>) {
+    return std::make_tuple(std::get<I>(bindings)...);
+}
+
+template <class... BINDINGS>
+constexpr auto MakeWideMapping(const std::tuple<BINDINGS...>& bindings) {
+    return DropPlaceholder(bindings, std::make_index_sequence<sizeof...(BINDINGS) - 1>{ });
+}
+
+#define DEFINE_WIDE_STRUCT(NAME, FIELDS) \
+    struct NAME : public SERIALIZATION<NAME>, LEXICOGRAPHICAL_EQUALITY<NAME> { \
+        FIELDS(WIDE_MEMBER) \
+        static constexpr auto DefineMemberMapping() { \
+            using SELF = NAME; \
+            return MakeWideMapping(std::make_tuple(FIELDS(WIDE_BINDING) nullptr)); \
+        } \
+    }
+
+DEFINE_WIDE_STRUCT(WIDE_10, WIDE_FIELDS_10);
+DEFINE_WIDE_STRUCT(WIDE_50, WIDE_FIELDS_50);
+DEFINE_WIDE_STRUCT(WIDE_200, WIDE_FIELDS_200);
+
+// Give every mapped field a distinct value
+template <class T> T MakeWide(int seed) {
+    auto result = T{ };
+    std::apply([&result, &seed](auto &&...element) { ((result.*(element.member_) = seed++ * 7919), ...); }, T::DefineMemberMapping());
+    return result;
+}
+
+#endif // !WIDE_SCHEMAS_HPP
@@ -0,0 +1,446 @@
+#include "Benchmark_Suite.hpp"
+#include "Foo.hpp"
+#include "Serial_Batch.hpp"
+#include "Serial_Binary_CRTP.hpp"
+#include "Serial_Columnar.hpp"
+#include "Serial_Delta.hpp"
+#include "Serial_Record_Log.hpp"
+#include "Serial_Stream.hpp"
+#include "Serial_View.hpp"
+#include "Suite_Schemas.hpp"
+#include "Wide_Schemas.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+namespace {
+
+// Keep results observable so the optimizer cannot discard the measured work
+volatile std::size_t sink = 0;
+
+template <class FUNCTION> double NanosecondsPerIteration(std::size_t iterations, FUNCTION&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    for (auto i = std::size_t{ 0 }; i < iterations; ++i) { function(); }
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / static_cast<double>(iterations);
+}
+
+// Linear scan over binding names, as done before the compile-time key index
+std::size_t LinearFind(const std::vector<std::string_view>& names, std::string_view key) {
+    auto location = names.begin();
+    while (location != names.end() && *location != key) { ++location; }
+    return static_cast<std::size_t>(location - names.begin());
+}
+
+template <class T> void BenchmarkWide(const char* name, std::size_t iterations) {
+    constexpr auto list = T::DefineMemberMapping();
+    auto keys = std::vector<std::string_view>{ };
+    std::apply([&keys](auto &&...element) { (keys.push_back(element.name_), ...); }, list);
+
+    const auto linear = NanosecondsPerIteration(iterations, [&keys] {
+        for (auto key : keys) { sink = sink + LinearFind(keys, key); }
+    });
+    const auto hashed = NanosecondsPerIteration(iterations, [&keys] {
+        for (auto key : keys) { sink = sink + keyIndex<T>.find(key); }
+    });
+
+    const auto text = MakeWide<T>(1).serialize();
+    const auto deserialize = NanosecondsPerIteration(iterations, [&text] {
+        sink = sink + static_cast<std::size_t>(T::deserialize(text).f000_);
+    });
+
+    std::printf("%-10s %6zu fields | key lookup: linear %10.1f ns, hashed %10.1f ns | deserialize %10.1f ns/record\n",
+        name, keys.size(), linear, hashed, deserialize);
+}
+
+// Text versus binary encoding of the same record, driven by the same mapping
+template <class T> void BenchmarkFormats(const char* name, const T& record, std::size_t iterations) {
+    auto buffer = std::string{ };
+    const auto textSerialize = NanosecondsPerIteration(iterations, [&buffer, &record] {
+        buffer.clear();
+        record.serializeInto(buffer);
+        sink = sink + buffer.size();
+    });
+    const auto text = record.serialize();
+    const auto textDeserialize = NanosecondsPerIteration(iterations, [&text, &record] {
+        sink = sink + (T::deserialize(text) == record);
+    });
+
+    const auto binarySerialize = NanosecondsPerIteration(iterations, [&buffer, &record] {
+        buffer.clear();
+        serializeBinaryFromMetadata(buffer, record);
+        sink = sink + buffer.size();
+    });
+    auto binary = std::string{ };
+    serializeBinaryFromMetadata(binary, record);
+    const auto binaryDeserialize = NanosecondsPerIteration(iterations, [&binary, &record] {
+        auto input = std::string_view{ binary };
+        sink = sink + (DeserializeBinaryFromMetadata<T>(input) == record);
+    });
+
+    std::printf("%-10s text %3zu bytes: serialize %8.1f ns, deserialize %8.1f ns | binary %3zu bytes: serialize %8.1f ns, deserialize %8.1f ns\n",
+        name, text.size(), textSerialize, textDeserialize, binary.size(), binarySerialize, binaryDeserialize);
+}
+
+// Scalar versus vectorized key/value splitting of a record with long free-text values
+void BenchmarkScanning(std::size_t textLength, std::size_t iterations) {
+    const auto text = std::string(textLength, 'x');
+    const auto record = FOO{ 1, text, '-' }.serialize();
+    const auto body = std::string_view{ record }.substr(1, record.size() - 2);
+    auto CountPair = [](std::string_view key, std::string_view value) { sink = sink + key.size() + value.size(); };
+
+    const auto scalar = NanosecondsPerIteration(iterations, [body, &CountPair] { ForEachKeyValue(body, ScalarScanner{ body }, CountPair); });
+    const auto indexed = NanosecondsPerIteration(iterations, [body, &CountPair] { ForEachKeyValueIndexed(body, CountPair); });
+    const auto megabytes = static_cast<double>(record.size()) / 1e6;
+    std::printf("scan %5zu bytes | scalar %8.1f ns (%7.1f MB/s), indexed %8.1f ns (%7.1f MB/s)\n",
+        record.size(), scalar, megabytes / (scalar * 1e-9), indexed, megabytes / (indexed * 1e-9));
+}
+
+// Free-text record with an owning member, so escaped text can be decoded outside an arena
+struct NOTE : public SERIALIZATION<NOTE> {
+    int id_{ 0 };
+    std::string text_{ };
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&NOTE::id_, "id"), MakeBinding(&NOTE::text_, "text"));
+    }
+};
+
+// Escaping of a free-text value: byte-wise versus vectorized search for characters to escape, and the cost of escapes on a round trip
+void BenchmarkEscaping(std::size_t textLength, std::size_t iterations) {
+    const auto clean = std::string(textLength, 'x');
+    auto delimited = clean;
+    for (auto i = std::size_t{ 15 }; i < delimited.size(); i += 16) { delimited[i] = ','; }
+
+    const auto scalar = NanosecondsPerIteration(iterations, [&clean] { sink = sink + escape::FindSpecialScalar(clean, 0); });
+    const auto vectorized = NanosecondsPerIteration(iterations, [&clean] { sink = sink + escape::FindSpecial(clean, 0); });
+    const auto megabytes = static_cast<double>(textLength) / 1e6;
+    std::printf("escape search %5zu bytes | scalar %8.1f ns (%7.1f MB/s), vectorized %8.1f ns (%7.1f MB/s)\n",
+        textLength, scalar, megabytes / (scalar * 1e-9), vectorized, megabytes / (vectorized * 1e-9));
+
+    for (auto delimiters : { false, true }) {
+        auto record = NOTE{ };
+        record.id_ = 1;
+        record.text_ = delimiters ? delimited : clean;
+        auto buffer = std::string{ };
+        const auto serialize = NanosecondsPerIteration(iterations, [&buffer, &record] {
+            buffer.clear();
+            record.serializeInto(buffer);
+            sink = sink + buffer.size();
+        });
+        auto target = NOTE{ };
+        const auto deserialize = NanosecondsPerIteration(iterations, [&buffer, &target] {
+            NOTE::deserializeInto(target, buffer);
+            sink = sink + target.text_.size();
+        });
+        std::printf("escape %-9s %5zu bytes | serialize %8.1f ns, deserialize %8.1f ns\n", delimiters ? "delimited" : "clean", textLength, serialize, deserialize);
+    }
+}
+
+// Row-wise text batches versus columnar batches: size, encode & decode time, and summing one field over every record
+void BenchmarkColumnar(std::size_t recordCount) {
+    constexpr std::string_view names[] = { "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel" };
+    auto records = std::vector<FOO>(recordCount);
+    for (auto i = std::size_t{ 0 }; i < recordCount; ++i) { records[i] = FOO{ static_cast<int>(i), names[i % 8], static_cast<char>('a' + i % 4) }; }
+    auto pool = WorkStealingPool{ 1 }; // Both formats on one thread
+
+    auto text = std::string{ };
+    const auto textSerialize = NanosecondsPerIteration(1, [&text, &records, &pool] { text = serializeBatch(records, pool); });
+    auto columns = std::string{ };
+    const auto columnarSerialize = NanosecondsPerIteration(1, [&columns, &records] { columns = serializeColumnar(records); });
+
+    auto decoded = std::vector<FOO>{ };
+    decoded.reserve(recordCount);
+    const auto textDeserialize = NanosecondsPerIteration(1, [&text, &decoded, &pool] { sink = sink + deserializeBatch(text, decoded, pool); });
+    decoded.clear();
+    const auto columnarDeserialize = NanosecondsPerIteration(1, [&columns, &decoded] { sink = sink + deserializeColumnar(columns, decoded); });
+
+    const auto textSum = NanosecondsPerIteration(1, [&text] {
+        auto sum = 0LL;
+        auto rows = std::vector<FOO>{ };
+        deserializeBatch(text, rows, DefaultPool());
+        for (const auto& row : rows) { sum += row.one_; }
+        sink = sink + static_cast<std::size_t>(sum);
+    });
+    const auto columnarSum = NanosecondsPerIteration(1, [&columns] {
+        auto sum = 0LL;
+        scanColumn<&FOO::one_>(columns, [&sum](int one) { sum += one; });
+        sink = sink + static_cast<std::size_t>(sum);
+    });
+
+    const auto perRecord = 1.0 / static_cast<double>(recordCount);
+    std::printf("columnar %zu records | text %9zu bytes: serialize %6.1f ns, deserialize %6.1f ns, sum one field %6.1f ns (all threads)\n",
+        recordCount, text.size(), textSerialize * perRecord, textDeserialize * perRecord, textSum * perRecord);
+    std::printf("columnar %zu records | columnar %5zu bytes: serialize %6.1f ns, deserialize %6.1f ns, sum one field %6.1f ns (one column)\n",
+        recordCount, columns.size(), columnarSerialize * perRecord, columnarDeserialize * perRecord, columnarSum * perRecord);
+}
+
+// Member-by-member equality, as done before runs of adjacent members were collapsed
+template <class T> bool MemberwiseEqual(const T& lhs, const T& rhs) {
+    return std::apply([&lhs, &rhs](auto &&...element) { return ((lhs.*(element.member_) == rhs.*(element.member_)) && ...); }, T::DefineMemberMapping());
+}
+
+template <class T> void BenchmarkComparison(const char* name, std::size_t iterations) {
+    constexpr auto last = std::get<std::tuple_size_v<decltype(T::DefineMemberMapping())> - 1>(T::DefineMemberMapping()).member_;
+    const auto lhs = MakeWide<T>(1);
+    auto rhs = MakeWide<T>(1);
+    // Records differ in their last member at most, so every member is compared; varying it keeps the comparison from being hoisted
+    const auto memberwise = NanosecondsPerIteration(iterations, [&lhs, &rhs] {
+        sink = sink + MemberwiseEqual(lhs, rhs);
+        rhs.*last = lhs.*last + static_cast<int>(sink & 1);
+    });
+    const auto runs = NanosecondsPerIteration(iterations, [&lhs, &rhs] {
+        sink = sink + (lhs == rhs);
+        rhs.*last = lhs.*last + static_cast<int>(sink & 1);
+    });
+    const auto hash = NanosecondsPerIteration(iterations, [&lhs] { sink = sink + MemberwiseHash{ }(lhs); });
+    std::printf("%-10s equality: memberwise %7.1f ns, operator== %7.1f ns | hash %7.1f ns\n", name, memberwise, runs, hash);
+}
+
+// Record-by-record serialization on one thread versus batches spread over the pool
+void BenchmarkBatch(std::size_t recordCount) {
+    auto names = std::vector<std::string>(recordCount);
+    auto records = std::vector<FOO>(recordCount);
+    for (auto i = std::size_t{ 0 }; i < recordCount; ++i) {
+        names[i] = "record number " + std::to_string(i);
+        records[i] = FOO{ static_cast<int>(i), names[i], '-' };
+    }
+
+    auto text = std::string{ };
+    const auto serial = NanosecondsPerIteration(1, [&records, &text] {
+        for (const auto& record : records) {
+            record.serializeInto(text);
+            text.push_back('\n');
+        }
+    });
+    const auto parallel = NanosecondsPerIteration(1, [&records] { sink = sink + serializeBatch(records).size(); });
+
+    auto decoded = std::vector<FOO>{ };
+    decoded.reserve(recordCount);
+    const auto serialDecode = NanosecondsPerIteration(1, [&decoded, &text] {
+        auto parser = MakeStreamDeserializer<FOO>([&decoded](const FOO& record) { decoded.push_back(record); });
+        parser.feed(text);
+    });
+    decoded.clear();
+    const auto parallelDecode = NanosecondsPerIteration(1, [&decoded, &text] { sink = sink + deserializeBatch(text, decoded); });
+
+    const auto count = static_cast<double>(recordCount);
+    std::printf("batch %zu records, %zu threads | serialize: serial %6.1f ns, batch %6.1f ns | deserialize: serial %6.1f ns, batch %6.1f ns (per record)\n",
+        recordCount, DefaultPool().threadCount(), serial / count, parallel / count, serialDecode / count, parallelDecode / count);
+}
+
+// Full snapshot versus a delta when a few fields change between ticks
+template <class T> void BenchmarkDelta(const char* name, std::size_t iterations) {
+    const auto previous = MakeWide<T>(1);
+    auto current = previous;
+    current.f000_ += 1;
+    current.f005_ += 1;
+    current.f009_ += 1;
+
+    auto text = std::string{ };
+    const auto snapshot = NanosecondsPerIteration(iterations, [&current, &text] {
+        text.clear();
+        current.serializeInto(text);
+        sink = sink + text.size();
+    });
+    const auto snapshotSize = text.size();
+    const auto encode = NanosecondsPerIteration(iterations, [&previous, &current, &text] {
+        text.clear();
+        diffInto(text, previous, current);
+        sink = sink + text.size();
+    });
+    auto target = previous;
+    const auto apply = NanosecondsPerIteration(iterations, [&target, &text] {
+        applyPatch(target, text);
+        sink = sink + static_cast<std::size_t>(target.f000_);
+    });
+    std::printf("%-10s 3 fields changed: snapshot %7.1f ns (%zu bytes) | diff %7.1f ns (%zu bytes), applyPatch %7.1f ns\n",
+        name, snapshot, snapshotSize, encode, text.size(), apply);
+}
+
+// Reading one field: full deserialization versus a lazy view, for the first and the last field of a record
+template <class T> void BenchmarkView(const char* name, std::size_t iterations) {
+    constexpr auto last = std::get<std::tuple_size_v<decltype(T::DefineMemberMapping())> - 1>(T::DefineMemberMapping()).member_;
+    const auto text = MakeWide<T>(1).serialize();
+    const auto full = NanosecondsPerIteration(iterations, [&text] { sink = sink + static_cast<std::size_t>(T::deserialize(text).f000_); });
+    const auto first = NanosecondsPerIteration(iterations, [&text] { sink = sink + static_cast<std::size_t>(SerializedView<T>{ text }.template get<&T::f000_>()); });
+    const auto back = NanosecondsPerIteration(iterations, [&text] { sink = sink + static_cast<std::size_t>(SerializedView<T>{ text }.template get<last>()); });
+    std::printf("%-10s read one field: deserialize %7.1f ns | view: first field %7.1f ns, last field %7.1f ns\n", name, full, first, back);
+}
+
+// Replaying a journal: newline-separated text read through iostreams and re-split, versus a mapped record log
+void BenchmarkRecordLog(std::size_t recordCount) {
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto textPath = (directory / "serial_benchmark_journal.txt").string();
+    const auto logPath = (directory / "serial_benchmark_journal.log").string();
+    std::filesystem::remove(logPath);
+    std::filesystem::remove(record_log::IndexPath(logPath));
+
+    auto names = std::vector<std::string>(recordCount);
+    auto records = std::vector<FOO>(recordCount);
+    for (auto i = std::size_t{ 0 }; i < recordCount; ++i) {
+        names[i] = "journal entry " + std::to_string(i);
+        records[i] = FOO{ static_cast<int>(i), names[i], '-' };
+    }
+    {
+        auto text = std::ofstream{ textPath, std::ios::binary };
+        for (const auto& record : records) { text << record.serialize() << '\n'; }
+    }
+    const auto append = NanosecondsPerIteration(1, [&records, &logPath] {
+        auto writer = RecordLogWriter<FOO>{ logPath };
+        for (const auto& record : records) { writer.append(record); }
+    });
+
+    const auto stream = NanosecondsPerIteration(1, [&textPath] {
+        auto input = std::ifstream{ textPath, std::ios::binary };
+        auto parser = MakeStreamDeserializer<FOO>([](const FOO& record) { sink = sink + static_cast<std::size_t>(record.one_); });
+        auto chunk = std::string(1 << 16, '\0');
+        while (input.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) || input.gcount() > 0) {
+            parser.feed(std::string_view{ chunk.data(), static_cast<std::size_t>(input.gcount()) });
+        }
+    });
+    const auto mapped = NanosecondsPerIteration(1, [&logPath] {
+        const auto reader = RecordLogReader<FOO>{ logPath };
+        reader.forEach(0, reader.size(), [](const FOO& record) { sink = sink + static_cast<std::size_t>(record.one_); });
+    });
+    const auto random = NanosecondsPerIteration(1, [&logPath, recordCount] {
+        const auto reader = RecordLogReader<FOO>{ logPath };
+        for (auto i = std::size_t{ 0 }, j = std::size_t{ 0 }; i < recordCount; ++i, j = (j + 7919) % recordCount) {
+            sink = sink + static_cast<std::size_t>(reader.get(j).one_);
+        }
+    });
+
+    const auto count = static_cast<double>(recordCount);
+    std::printf("journal %zu records | append %6.1f ns | replay: iostream %6.1f ns, mapped scan %6.1f ns, mapped by index %6.1f ns (per record)\n",
+        recordCount, append / count, stream / count, mapped / count, random / count);
+    std::filesystem::remove(textPath);
+    std::filesystem::remove(logPath);
+    std::filesystem::remove(record_log::IndexPath(logPath));
+}
+
+inline constexpr std::size_t columnarSuiteRows = 64;
+
+// Every operation of the suite on one schema; a new format adds its rows here
+template <class T> void RunSuite(const char* schema, const T& record, const suite::Options& options, std::vector<suite::Result>& results) {
+    auto buffer = std::string{ };
+    const auto text = record.serialize();
+    const auto fingerprinted = record.serializeFingerprinted();
+    auto binary = std::string{ };
+    serializeBinaryFromMetadata(binary, record);
+    auto target = T{ };
+    auto other = record;
+
+    auto Add = [&results](suite::Result result) {
+        suite::Print(result);
+        results.push_back(std::move(result));
+    };
+    Add(suite::Measure(schema, "text", "serialize", text.size(), options, [&record] { sink = sink + record.serialize().size(); }));
+    Add(suite::Measure(schema, "text", "serializeInto", text.size(), options, [&buffer, &record] {
+        buffer.clear();
+        record.serializeInto(buffer);
+        sink = sink + buffer.size();
+    }));
+    Add(suite::Measure(schema, "text", "deserialize", text.size(), options, [&text, &record] { sink = sink + (T::deserialize(text) == record); }));
+    Add(suite::Measure(schema, "text", "deserializeInto", text.size(), options, [&text, &target] {
+        T::deserializeInto(target, text);
+        sink = sink + 1;
+    }));
+    Add(suite::Measure(schema, "tagged", "serializeInto", fingerprinted.size(), options, [&buffer, &record] {
+        buffer.clear();
+        record.serializeFingerprintedInto(buffer);
+        sink = sink + buffer.size();
+    }));
+    Add(suite::Measure(schema, "tagged", "deserializeInto", fingerprinted.size(), options, [&fingerprinted, &target] {
+        T::deserializeInto(target, fingerprinted);
+        sink = sink + 1;
+    }));
+    Add(suite::Measure(schema, "binary", "serialize", binary.size(), options, [&buffer, &record] {
+        buffer.clear();
+        serializeBinaryFromMetadata(buffer, record);
+        sink = sink + buffer.size();
+    }));
+    Add(suite::Measure(schema, "binary", "deserialize", binary.size(), options, [&binary, &record] {
+        auto input = std::string_view{ binary };
+        sink = sink + (DeserializeBinaryFromMetadata<T>(input) == record);
+    }));
+    Add(suite::Measure(schema, "object", "operator==", sizeof(T), options, [&record, &other] { sink = sink + (record == other); }));
+
+    // Columnar encoding works on whole batches: these rows time a batch of copies of the record
+    const auto rows = std::vector<T>(columnarSuiteRows, record);
+    const auto columns = serializeColumnar(rows);
+    auto decoded = std::vector<T>{ };
+    decoded.reserve(rows.size());
+    Add(suite::MeasureBatch(schema, "column", "serialize", rows.size(), columns.size() / rows.size(), options, [&rows] {
+        sink = sink + serializeColumnar(rows).size();
+    }));
+    Add(suite::MeasureBatch(schema, "column", "deserialize", rows.size(), columns.size() / rows.size(), options, [&columns, &decoded] {
+        decoded.clear();
+        sink = sink + deserializeColumnar(columns, decoded);
+    }));
+}
+
+void RunSuites(const suite::Options& options) {
+    auto results = std::vector<suite::Result>{ };
+    suite::PrintHeader();
+    RunSuite("FOO", FOO{ 123456, "a short text field", '-' }, options, results);
+    RunSuite("FOO_BAR", MakeFooBar(), options, results);
+    RunSuite("SPARSE", MakeSparse(), options, results);
+    RunSuite("WIDE_10", MakeWide<WIDE_10>(1), options, results);
+    RunSuite("WIDE_50", MakeWide<WIDE_50>(1), options, results);
+    RunSuite("WIDE_200", MakeWide<WIDE_200>(1), options, results);
+
+    if (options.jsonPath != nullptr && !suite::WriteJson(options.jsonPath, options.label, results)) {
+        std::fprintf(stderr, "Could not write %s\n", options.jsonPath);
+    }
+}
+
+void RunStudies() {
+    BenchmarkScanning(16, 1000000);
+    BenchmarkScanning(1000, 100000);
+    BenchmarkEscaping(16, 1000000);
+    BenchmarkEscaping(1000, 100000);
+    BenchmarkFormats("FOO", FOO{ 123456, "a short text field", '-' }, 1000000);
+    BenchmarkFormats("WIDE_10", MakeWide<WIDE_10>(1), 200000);
+
+    BenchmarkWide<WIDE_10>("WIDE_10", 200000);
+    BenchmarkWide<WIDE_50>("WIDE_50", 40000);
+    BenchmarkWide<WIDE_200>("WIDE_200", 10000);
+
+    BenchmarkComparison<WIDE_10>("WIDE_10", 10000000);
+    BenchmarkComparison<WIDE_50>("WIDE_50", 2000000);
+    BenchmarkComparison<WIDE_200>("WIDE_200", 500000);
+
+    BenchmarkDelta<WIDE_10>("WIDE_10", 200000);
+    BenchmarkDelta<WIDE_200>("WIDE_200", 10000);
+
+    BenchmarkView<WIDE_10>("WIDE_10", 200000);
+    BenchmarkView<WIDE_200>("WIDE_200", 10000);
+
+    BenchmarkBatch(1000000);
+    BenchmarkColumnar(1000000);
+    BenchmarkRecordLog(1000000);
+}
+
+} // namespace
+
+// Usage: benchmarks [--json <file>] [--label <text>] [--quick] [--suite-only]
+int main(int argc, char* argv[]) {
+    auto options = suite::Options{ };
+    for (auto i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) { options.jsonPath = argv[++i]; }
+        else if (std::strcmp(argv[i], "--label") == 0 && i + 1 < argc) { options.label = argv[++i]; }
+        else if (std::strcmp(argv[i], "--quick") == 0) { options.sampleCount = 1000; }
+        else if (std::strcmp(argv[i], "--suite-only") == 0) { options.suiteOnly = true; }
+        else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    RunSuites(options);
+    if (!options.suiteOnly) { RunStudies(); }
+    return 0;
+}
@@ -0,0 +1,119 @@
+#ifndef SERIAL_ARENA_HPP
+#define SERIAL_ARENA_HPP 1
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+/// <summary>
+/// Memory resource used for the variable-length data of objects being deserialized, e.g. a std::pmr::monotonic_buffer_resource
+/// serving a whole batch of records and released in one call.
+/// The resource is installed per thread for the duration of one deserialization, so the recursive decoders need no extra parameter.
+/// While one is installed, std::pmr strings & containers are built on it and std::string_view values are copied into it,
+/// so the results no longer refer to the input buffer.
+/// </summary>
+namespace arena {
+
+// Resource installed on this thread, or nullptr outside an arena deserialization
+inline std::pmr::memory_resource*& CurrentResource() {
+    thread_local std::pmr::memory_resource* resource = nullptr;
+    return resource;
+}
+
+// Resource for allocator-aware values: the installed one, otherwise the process default
+inline std::pmr::memory_resource* Resource() {
+    auto* resource = CurrentResource();
+    return resource != nullptr ? resource : std::pmr::get_default_resource();
+}
+
+// Install a resource on this thread for the lifetime of the guard; nests
+class ScopedResource {
+public:
+    explicit ScopedResource(std::pmr::memory_resource* resource) : previous_{ CurrentResource() } { CurrentResource() = resource; }
+
+    ScopedResource(const ScopedResource&) = delete;
+    ScopedResource& operator=(const ScopedResource&) = delete;
+
+    ~ScopedResource() { CurrentResource() = previous_; }
+
+private:
+    std::pmr::memory_resource* previous_;
+};
+
+// Serializes allocations from a resource which is not thread-safe, e.g. a std::pmr::monotonic_buffer_resource,
+// so it may be installed around deserializeBatch(), whose records are decoded on several threads. Must outlive the objects built on it.
+class SynchronizedResource : public std::pmr::memory_resource {
+public:
+    explicit SynchronizedResource(std::pmr::memory_resource* upstream) : upstream_{ upstream } {}
+
+    SynchronizedResource(const SynchronizedResource&) = delete;
+    SynchronizedResource& operator=(const SynchronizedResource&) = delete;
+
+    [[nodiscard]] std::pmr::memory_resource* upstream() const { return upstream_; }
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        return upstream_->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        upstream_->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource* upstream_;
+    std::mutex mutex_{ };
+};
+
+// Whether storage from this allocator may be kept: always, unless a different resource is installed
+template <class ALLOCATOR> bool IsOn(const ALLOCATOR& allocator) {
+    auto* resource = CurrentResource();
+    return resource == nullptr || allocator.resource() == resource;
+}
+
+// Types which allocate through a std::pmr::polymorphic_allocator, e.g. std::pmr::string & std::pmr::vector
+template <class T>
+inline constexpr bool isAllocatorAware = std::uses_allocator_v<T, std::pmr::polymorphic_allocator<std::byte>>;
+
+// Default-constructed value, allocating from the installed resource when it allocates at all
+template <class T> constexpr T MakeValue() {
+    if constexpr (isAllocatorAware<T>) { return T(typename T::allocator_type{ Resource() }); }
+    else { return T{ }; }
+}
+
+// Move a decoded value into an existing member. Polymorphic allocators do not propagate on assignment, so a member built on another
+// resource would copy the value out of the arena; such a member is rebuilt around the decoded value instead.
+template <class T> constexpr void Assign(T& member, T&& value) {
+    if constexpr (isAllocatorAware<T>) {
+        if (member.get_allocator() != value.get_allocator()) {
+            std::destroy_at(&member);
+            ::new (static_cast<void*>(std::addressof(member))) T(std::move(value));
+            return;
+        }
+    }
+    member = std::move(value);
+}
+
+// Copy of a view's characters owned by the installed resource; the view itself when none is installed
+inline std::string_view Retain(std::string_view sv) {
+    auto* resource = CurrentResource();
+    if (resource == nullptr || sv.empty()) { return sv; }
+    auto* copy = static_cast<char*>(resource->allocate(sv.size(), alignof(char)));
+    std::memcpy(copy, sv.data(), sv.size());
+    return { copy, sv.size() };
+}
+
+} // namespace arena
+
+#endif // !SERIAL_ARENA_HPP
@@ -0,0 +1,305 @@
+#ifndef SERIAL_BATCH_HPP
+#define SERIAL_BATCH_HPP 1
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Serial_Arena.hpp"
+#include "Serial_CRTP.hpp"
+
+/// <summary>
+/// Fixed set of threads, each owning a deque of tasks. A thread pops from the back of its own deque and, once that runs dry,
+/// steals from the front of the others, so uneven chunks even out without a shared queue becoming the bottleneck.
+/// The thread calling parallelFor() takes part in the work, so a pool of one thread runs everything inline.
+/// A parallelFor() called from within a task, e.g. a batch serialized from inside another batch, runs inline on the calling thread
+/// rather than wait for threads which may themselves be waiting on it.
+/// </summary>
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(std::size_t threadCount = std::max(1u, std::thread::hardware_concurrency())) : queues_(std::max(threadCount, std::size_t{ 1 })) {
+        workers_.reserve(queues_.size() - 1);
+        for (auto self = std::size_t{ 1 }; self < queues_.size(); ++self) {
+            workers_.emplace_back([this, self] { WorkerLoop(self); });
+        }
+    }
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+        {
+            std::lock_guard<std::mutex> lock{ wakeMutex_ };
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) { worker.join(); }
+    }
+
+    // Number of threads sharing the work, including the caller
+    [[nodiscard]] std::size_t threadCount() const { return queues_.size(); }
+
+    // Run body(index) for every index in [0, count) and wait for all of them; rethrows the first exception thrown by body
+    template <class FUNCTION> void parallelFor(std::size_t count, FUNCTION&& body) {
+        if (count == 0) { return; }
+        if (InsideTask()) {
+            for (auto index = std::size_t{ 0 }; index < count; ++index) { body(index); }
+            return;
+        }
+
+        auto job = Job{ };
+        job.run = [&body](std::size_t index) { body(index); };
+        job.remaining = count;
+
+        std::lock_guard<std::mutex> jobLock{ jobMutex_ }; // One batch at a time
+        // Deal out contiguous runs of indices so neighbouring work stays on one thread unless stolen
+        for (auto q = std::size_t{ 0 }; q < queues_.size(); ++q) {
+            std::lock_guard<std::mutex> lock{ queues_[q].mutex };
+            for (auto index = q * count / queues_.size(); index < (q + 1) * count / queues_.size(); ++index) {
+                queues_[q].tasks.push_back(Task{ &job, index });
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock{ wakeMutex_ };
+            ++generation_;
+        }
+        wake_.notify_all();
+
+        RunTasks(0);
+        std::unique_lock<std::mutex> lock{ job.mutex };
+        job.done.wait(lock, [&job] { return job.remaining == 0; });
+        if (job.error) { std::rethrow_exception(job.error); }
+    }
+
+private:
+    struct Job {
+        std::function<void(std::size_t)> run;
+        std::mutex mutex;
+        std::condition_variable done;
+        std::size_t remaining{ 0 }; // Guarded by mutex, so the job outlives the last notification
+        std::exception_ptr error;
+    };
+
+    struct Task {
+        Job* job;
+        std::size_t index;
+    };
+
+    struct Queue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void WorkerLoop(std::size_t self) {
+        auto seenGeneration = std::size_t{ 0 };
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock{ wakeMutex_ };
+                wake_.wait(lock, [this, seenGeneration] { return stopping_ || generation_ != seenGeneration; });
+                if (stopping_) { return; }
+                seenGeneration = generation_;
+            }
+            RunTasks(self);
+        }
+    }
+
+    // Drain the own queue, then steal, until no task is left anywhere
+    void RunTasks(std::size_t self) {
+        auto task = Task{ };
+        while (PopOwn(self, task) || Steal(self, task)) { Execute(task); }
+    }
+
+    bool PopOwn(std::size_t self, Task& task) {
+        std::lock_guard<std::mutex> lock{ queues_[self].mutex };
+        if (queues_[self].tasks.empty()) { return false; }
+        task = queues_[self].tasks.back();
+        queues_[self].tasks.pop_back();
+        return true;
+    }
+
+    bool Steal(std::size_t self, Task& task) {
+        for (auto offset = std::size_t{ 1 }; offset < queues_.size(); ++offset) {
+            auto& victim = queues_[(self + offset) % queues_.size()];
+            std::lock_guard<std::mutex> lock{ victim.mutex };
+            if (victim.tasks.empty()) { continue; }
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    // Whether this thread is running a task of any pool
+    static bool& InsideTask() {
+        thread_local bool inside = false;
+        return inside;
+    }
+
+    static void Execute(const Task& task) {
+        auto error = std::exception_ptr{ };
+        InsideTask() = true;
+        try {
+            task.job->run(task.index);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        InsideTask() = false;
+        std::lock_guard<std::mutex> lock{ task.job->mutex };
+        if (error && !task.job->error) { task.job->error = error; }
+        if (--task.job->remaining == 0) { task.job->done.notify_all(); }
+    }
+
+    std::vector<Queue> queues_;
+    std::vector<std::thread> workers_{ };
+    std::mutex jobMutex_{ };
+    std::mutex wakeMutex_{ };
+    std::condition_variable wake_{ };
+    std::size_t generation_{ 0 };
+    bool stopping_{ false };
+};
+
+// Process-wide pool sized to the hardware, created on first use
+inline WorkStealingPool& DefaultPool() {
+    static auto pool = WorkStealingPool{ };
+    return pool;
+}
+
+namespace batch {
+
+inline constexpr std::size_t chunksPerThread = 8; // Enough slack for stealing to balance uneven records
+inline constexpr std::size_t minSegmentSize = 4096; // Bytes of text below which splitting the boundary scan does not pay off
+
+// Half-open range of items handled by one chunk when 'count' items are split into 'chunkCount' near-equal chunks
+inline std::pair<std::size_t, std::size_t> ChunkBounds(std::size_t count, std::size_t chunkCount, std::size_t chunk) {
+    return { chunk * count / chunkCount, (chunk + 1) * count / chunkCount };
+}
+
+// Record boundaries within one segment of the text, given the brace depth at which the segment begins
+struct SegmentBoundaries {
+    std::vector<std::size_t> begins{ };
+    std::vector<std::size_t> ends{ }; // One past each closing brace
+};
+
+inline void FindBoundaries(std::string_view text, std::size_t begin, std::size_t end, long long depth, SegmentBoundaries& boundaries) {
+    for (auto pos = begin; pos < end; ++pos) {
+        const auto c = text[pos];
+        if (depth <= 0) {
+            if (c == '{') {
+                depth = 1;
+                boundaries.begins.push_back(pos);
+            }
+            else if (!IsWhitespace(c) && c != ' ' && c != '\r') {
+                throw std::runtime_error{ "Error parsing batch: unexpected character between records." };
+            }
+        }
+        else if (c == '{') { ++depth; }
+        else if (c == '}' && --depth == 0) { boundaries.ends.push_back(pos + 1); }
+    }
+}
+
+} // namespace batch
+
+///////////////////////
+
+// Serialize records back to back, one per line. Each chunk of records is serialized into its own buffer in parallel,
+// then the buffers are copied into place at offsets given by a prefix sum over their sizes.
+template <class T> std::string serializeBatch(const T* records, std::size_t count, WorkStealingPool& pool = DefaultPool()) {
+    const auto chunkCount = std::min(count, pool.threadCount() * batch::chunksPerThread);
+    auto buffers = std::vector<std::string>(chunkCount);
+    pool.parallelFor(chunkCount, [records, count, chunkCount, &buffers](std::size_t chunk) {
+        const auto [begin, end] = batch::ChunkBounds(count, chunkCount, chunk);
+        auto& buffer = buffers[chunk];
+        for (auto i = begin; i < end; ++i) {
+            records[i].serializeInto(buffer);
+            buffer.push_back('\n');
+        }
+    });
+
+    auto offsets = std::vector<std::size_t>(chunkCount + 1);
+    for (auto chunk = std::size_t{ 0 }; chunk < chunkCount; ++chunk) { offsets[chunk + 1] = offsets[chunk] + buffers[chunk].size(); }
+
+    auto output = std::string(offsets.back(), '\0');
+    pool.parallelFor(chunkCount, [&output, &offsets, &buffers](std::size_t chunk) {
+        std::memcpy(&output[offsets[chunk]], buffers[chunk].data(), buffers[chunk].size());
+    });
+    return output;
+}
+
+template <class T> std::string serializeBatch(const std::vector<T>& records, WorkStealingPool& pool = DefaultPool()) {
+    return serializeBatch(records.data(), records.size(), pool);
+}
+
+// Deserialize back-to-back records (as written by serializeBatch() or a stream of serialize() calls), appending them to 'output'.
+// Record boundaries are found in parallel: one pass sums the brace depth change of each segment, a prefix sum gives every
+// segment its starting depth, and a second pass lists the records beginning & ending in each segment. Records are then decoded in parallel.
+// Views held by the deserialized objects (e.g. std::string_view members) point into 'text'. Returns the number of records appended.
+// A memory resource installed on the calling thread (arena::ScopedResource) is installed on every worker for its records; as several threads
+// allocate from it at once, it must be thread-safe, e.g. std::pmr::synchronized_pool_resource or an arena::SynchronizedResource.
+template <class T> std::size_t deserializeBatch(std::string_view text, std::vector<T>& output, WorkStealingPool& pool = DefaultPool()) {
+    static_assert(std::is_default_constructible_v<T>);
+    const auto segmentCount = std::max(std::size_t{ 1 }, std::min(text.size() / batch::minSegmentSize, pool.threadCount() * batch::chunksPerThread));
+
+    auto depths = std::vector<long long>(segmentCount + 1);
+    pool.parallelFor(segmentCount, [text, segmentCount, &depths](std::size_t segment) {
+        const auto [begin, end] = batch::ChunkBounds(text.size(), segmentCount, segment);
+        auto delta = 0LL;
+        for (auto pos = begin; pos < end; ++pos) { delta += (text[pos] == '{') - (text[pos] == '}'); }
+        depths[segment + 1] = delta;
+    });
+    for (auto segment = std::size_t{ 0 }; segment < segmentCount; ++segment) { depths[segment + 1] += depths[segment]; }
+    if (depths.back() != 0) { throw std::runtime_error{ "Error parsing batch: unbalanced braces." }; }
+
+    auto boundaries = std::vector<batch::SegmentBoundaries>(segmentCount);
+    pool.parallelFor(segmentCount, [text, segmentCount, &depths, &boundaries](std::size_t segment) {
+        const auto [begin, end] = batch::ChunkBounds(text.size(), segmentCount, segment);
+        batch::FindBoundaries(text, begin, end, depths[segment], boundaries[segment]);
+    });
+
+    // Gather boundaries in text order; the n-th opening brace pairs with the n-th closing one
+    auto begins = std::vector<std::size_t>{ };
+    auto ends = std::vector<std::size_t>{ };
+    for (const auto& segment : boundaries) {
+        begins.insert(begins.end(), segment.begins.begin(), segment.begins.end());
+        ends.insert(ends.end(), segment.ends.begin(), segment.ends.end());
+    }
+    if (begins.size() != ends.size()) { throw std::runtime_error{ "Error parsing batch: unterminated record." }; }
+
+    const auto first = output.size();
+    const auto count = begins.size();
+    output.resize(first + count);
+    const auto chunkCount = std::min(count, pool.threadCount() * batch::chunksPerThread);
+    auto* resource = arena::CurrentResource();
+    try {
+        pool.parallelFor(chunkCount, [text, count, chunkCount, first, resource, &begins, &ends, &output](std::size_t chunk) {
+            const auto scope = arena::ScopedResource{ resource };
+            const auto [begin, end] = batch::ChunkBounds(count, chunkCount, chunk);
+            for (auto i = begin; i < end; ++i) {
+                auto record = T::deserialize(text.substr(begins[i], ends[i] - begins[i]));
+                if (resource == nullptr) { output[first + i] = std::move(record); }
+                else { // Assignment would copy std::pmr members off the arena, onto the default-constructed element's resource
+                    std::destroy_at(&output[first + i]);
+                    ::new (static_cast<void*>(&output[first + i])) T(std::move(record));
+                }
+            }
+        });
+    }
+    catch (...) {
+        output.resize(first); // Leave the destination as it was
+        throw;
+    }
+    return count;
+}
+
+#endif // !SERIAL_BATCH_HPP
@@ -0,0 +1,447 @@
+#ifndef SERIAL_BINARY_CRTP_HPP
+#define SERIAL_BINARY_CRTP_HPP 1
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "Serial_Type_Traits.hpp"
+
+/// <summary>
+/// Compact binary encoding driven by the same DefineMemberMapping() metadata as the text format.
+/// Members are written in mapping order without names:
+///     scalars (integral, enum, floating point) as fixed-width little-endian,
+///     strings as a 32-bit little-endian length followed by the bytes,
+///     optionals as a bit in a per-object presence bitmap followed by the value only when present,
+///     vectors, sets & maps as a 32-bit little-endian element count followed by the elements (map entries as key then value),
+///     std::arrays as their elements alone, the count being part of the type,
+///     nested mapped objects recursively in place.
+/// Objects made only of fixed-width members have a layout fully known at compile time, so they encode & decode as straight-line stores & loads.
+/// </summary>
+namespace binary {
+
+using LengthPrefix = std::uint32_t;
+
+// Length or count of a string or container, which must fit its prefix rather than wrap into a corrupt stream
+inline std::size_t CheckedLength(std::size_t length) {
+    if (length > 0xFFFFFFFF) { throw std::length_error{ "String or container too large for binary length prefix." }; }
+    return length;
+}
+
+// Byte-wise shifts keep this portable across host endianness; compilers merge them into single stores & loads
+template <class UNSIGNED>
+constexpr void StoreLittleEndian(char* destination, UNSIGNED value) {
+    for (auto i = std::size_t{ 0 }; i < sizeof(UNSIGNED); ++i) {
+        destination[i] = static_cast<char>(static_cast<unsigned char>(value >> (8 * i)));
+    }
+}
+
+template <class UNSIGNED>
+constexpr UNSIGNED LoadLittleEndian(const char* source) {
+    auto value = UNSIGNED{ 0 };
+    for (auto i = std::size_t{ 0 }; i < sizeof(UNSIGNED); ++i) {
+        value |= static_cast<UNSIGNED>(static_cast<unsigned char>(source[i])) << (8 * i);
+    }
+    return value;
+}
+
+template <std::size_t SIZE> struct UnsignedOfSizeImpl;
+template <> struct UnsignedOfSizeImpl<1> { using type = std::uint8_t; };
+template <> struct UnsignedOfSizeImpl<2> { using type = std::uint16_t; };
+template <> struct UnsignedOfSizeImpl<4> { using type = std::uint32_t; };
+template <> struct UnsignedOfSizeImpl<8> { using type = std::uint64_t; };
+
+template <class T>
+using UnsignedOfSize = typename UnsignedOfSizeImpl<sizeof(T)>::type;
+
+template <class T>
+inline constexpr bool isScalar = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+template <class T> constexpr bool IsFixedWidth();
+
+template <class T> constexpr bool IsFixedWidthMapping() {
+    return std::apply([](auto &&...element) {
+        return (IsFixedWidth<std::decay_t<decltype(std::declval<T>().*(element.member_))>>() && ...);
+        }, T::DefineMemberMapping());
+}
+
+// Fixed-width types: scalars, and mapped objects made only of fixed-width types
+template <class T> constexpr bool IsFixedWidth() {
+    if constexpr (isScalar<T>) { return true; }
+    else if constexpr (serializable::traits::isStdArray<T>) { return IsFixedWidth<typename T::value_type>(); }
+    else if constexpr (serializable::traits::hasMemberMapping<T>) { return IsFixedWidthMapping<T>(); }
+    else { return false; }
+}
+
+template <class T>
+inline constexpr bool isFixedWidth = IsFixedWidth<T>();
+
+template <class T> constexpr std::size_t FixedSize() {
+    if constexpr (isScalar<T>) { return sizeof(T); }
+    else if constexpr (serializable::traits::isStdArray<T>) { return std::tuple_size_v<T> * FixedSize<typename T::value_type>(); }
+    else {
+        return std::apply([](auto &&...element) {
+            return (std::size_t{ 0 } + ... + FixedSize<std::decay_t<decltype(std::declval<T>().*(element.member_))>>());
+            }, T::DefineMemberMapping());
+    }
+}
+
+// Encoded size of a fixed-width type, known at compile time
+template <class T>
+inline constexpr std::size_t fixedSize = FixedSize<T>();
+
+template <class T> constexpr std::size_t CountOptionals() {
+    return std::apply([](auto &&...element) {
+        return (std::size_t{ 0 } + ... + (serializable::traits::isOptional<std::decay_t<decltype(std::declval<T>().*(element.member_))>> ? 1 : 0));
+        }, T::DefineMemberMapping());
+}
+
+// Bytes of presence bitmap leading each encoded object: one bit per optional member in mapping order
+template <class T>
+inline constexpr std::size_t presenceBytes = (CountOptionals<T>() + 7) / 8;
+
+inline void RequireBytes(std::string_view input, std::size_t count) {
+    if (input.size() < count) { throw std::runtime_error{ "Error parsing binary: truncated input." }; }
+}
+
+// Container elements have no presence bitmap to record whether an optional is engaged
+template <class T> constexpr void AssertEncodableElement() {
+    static_assert(!serializable::traits::isOptional<T>, "Optional container elements have no binary encoding");
+}
+
+///////////////////////
+
+template <class T> void EncodeScalar(char* destination, T value) {
+    if constexpr (std::is_enum_v<T>) {
+        EncodeScalar(destination, static_cast<std::underlying_type_t<T>>(value));
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+        auto bits = UnsignedOfSize<T>{ };
+        std::memcpy(&bits, &value, sizeof(T));
+        StoreLittleEndian(destination, bits);
+    }
+    else {
+        StoreLittleEndian(destination, static_cast<UnsignedOfSize<T>>(value));
+    }
+}
+
+template <class T> T DecodeScalar(const char* source) {
+    if constexpr (std::is_enum_v<T>) {
+        return static_cast<T>(DecodeScalar<std::underlying_type_t<T>>(source));
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+        const auto bits = LoadLittleEndian<UnsignedOfSize<T>>(source);
+        auto value = T{ };
+        std::memcpy(&value, &bits, sizeof(T));
+        return value;
+    }
+    else if constexpr (std::is_same_v<T, bool>) {
+        return LoadLittleEndian<std::uint8_t>(source) != 0;
+    }
+    else {
+        return static_cast<T>(LoadLittleEndian<UnsignedOfSize<T>>(source));
+    }
+}
+
+// Straight-line stores at compile-time offsets
+template <class T> void EncodeFixed(char* destination, const T& object) {
+    if constexpr (isScalar<T>) {
+        EncodeScalar(destination, object);
+    }
+    else if constexpr (serializable::traits::isStdArray<T>) {
+        for (const auto& element : object) {
+            EncodeFixed(destination, element);
+            destination += fixedSize<typename T::value_type>;
+        }
+    }
+    else {
+        std::apply([destination, &object](auto &&...element) {
+            auto offset = std::size_t{ 0 };
+            ((EncodeFixed(destination + offset, object.*(element.member_)), offset += fixedSize<std::decay_t<decltype(object.*(element.member_))>>), ...);
+            }, T::DefineMemberMapping());
+    }
+}
+
+// Straight-line loads at compile-time offsets
+template <class T> void DecodeFixed(const char* source, T& object) {
+    if constexpr (isScalar<T>) {
+        object = DecodeScalar<T>(source);
+    }
+    else if constexpr (serializable::traits::isStdArray<T>) {
+        for (auto& element : object) {
+            DecodeFixed(source, element);
+            source += fixedSize<typename T::value_type>;
+        }
+    }
+    else {
+        std::apply([source, &object](auto &&...element) {
+            auto offset = std::size_t{ 0 };
+            ((DecodeFixed(source + offset, object.*(element.member_)), offset += fixedSize<std::decay_t<decltype(object.*(element.member_))>>), ...);
+            }, T::DefineMemberMapping());
+    }
+}
+
+///////////////////////
+
+template <class T> std::size_t EncodedSize(const T& object);
+
+template <class T> std::size_t EncodedSizeFromMetadata(const T& object) {
+    if constexpr (isFixedWidth<T>) {
+        return fixedSize<T>;
+    }
+    else {
+        return std::apply([&object](auto &&...element) {
+            return (presenceBytes<T> + ... + EncodedSize(object.*(element.member_)));
+            }, T::DefineMemberMapping());
+    }
+}
+
+// Exact number of bytes Encode() will write
+template <class T> std::size_t EncodedSize(const T& object) {
+    using namespace serializable::traits;
+
+    if constexpr (isFixedWidth<T>) {
+        return fixedSize<T>;
+    }
+    else if constexpr (isOptional<T>) {
+        return object.has_value() ? EncodedSize(object.value()) : 0;
+    }
+    else if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>) {
+        return sizeof(LengthPrefix) + CheckedLength(object.size());
+    }
+    else if constexpr (isContainer<T>) {
+        auto size = std::size_t{ 0 };
+        if constexpr (!isStdArray<T>) {
+            CheckedLength(object.size());
+            size += sizeof(LengthPrefix);
+        }
+        for (const auto& element : object) {
+            if constexpr (isMap<T>) { size += EncodedSize(element.first) + EncodedSize(element.second); }
+            else { size += EncodedSize(element); }
+        }
+        return size;
+    }
+    else if constexpr (hasMemberMapping<T>) {
+        return EncodedSizeFromMetadata(object);
+    }
+    else {
+        static_assert(hasMemberMapping<T>, "Type has no binary encoding");
+        return 0;
+    }
+}
+
+template <class T> void Encode(char*& cursor, const T& object);
+
+template <class T> void EncodeFromMetadata(char*& cursor, const T& object) {
+    constexpr auto metadata = T::DefineMemberMapping();
+    if constexpr (isFixedWidth<T>) {
+        EncodeFixed(cursor, object);
+        cursor += fixedSize<T>;
+    }
+    else {
+        // Presence bitmap leads the object so a reader knows which optionals follow
+        auto* const bitmap = cursor;
+        std::memset(bitmap, 0, presenceBytes<T>);
+        cursor += presenceBytes<T>;
+
+        auto optionalIndex = std::size_t{ 0 };
+        auto EncodeElement = [&cursor, &object, bitmap, &optionalIndex](auto&& element) {
+            const auto& value = object.*(element.member_);
+            if constexpr (serializable::traits::isOptional<std::decay_t<decltype(value)>>) {
+                if (value.has_value()) { bitmap[optionalIndex / 8] |= static_cast<char>(1 << (optionalIndex % 8)); }
+                ++optionalIndex;
+            }
+            Encode(cursor, value);
+        };
+        std::apply([&EncodeElement](auto &&...element) { (EncodeElement(element), ...); }, metadata);
+        static_cast<void>(bitmap);
+    }
+}
+
+// Write the object at the cursor, which must have EncodedSize(object) bytes available; sizing first also rejects oversized lengths before any byte is written
+template <class T> void Encode(char*& cursor, const T& object) {
+    using namespace serializable::traits;
+
+    if constexpr (isScalar<T>) {
+        EncodeScalar(cursor, object);
+        cursor += sizeof(T);
+    }
+    else if constexpr (isOptional<T>) {
+        if (object.has_value()) { Encode(cursor, object.value()); }
+    }
+    else if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>) {
+        StoreLittleEndian(cursor, static_cast<LengthPrefix>(object.size())); // In range, checked by EncodedSize()
+        cursor += sizeof(LengthPrefix);
+        std::memcpy(cursor, object.data(), object.size());
+        cursor += object.size();
+    }
+    else if constexpr (isFixedWidth<T>) {
+        EncodeFixed(cursor, object);
+        cursor += fixedSize<T>;
+    }
+    else if constexpr (isContainer<T>) {
+        if constexpr (!isStdArray<T>) {
+            StoreLittleEndian(cursor, static_cast<LengthPrefix>(object.size())); // In range, checked by EncodedSize()
+            cursor += sizeof(LengthPrefix);
+        }
+        for (const auto& element : object) {
+            if constexpr (isMap<T>) {
+                AssertEncodableElement<typename T::key_type>();
+                AssertEncodableElement<typename T::mapped_type>();
+                Encode(cursor, element.first);
+                Encode(cursor, element.second);
+            }
+            else {
+                AssertEncodableElement<typename T::value_type>();
+                Encode(cursor, element);
+            }
+        }
+    }
+    else {
+        EncodeFromMetadata(cursor, object);
+    }
+}
+
+template <class T> void Decode(std::string_view& input, T& object);
+
+template <class T> void DecodeFromMetadata(std::string_view& input, T& object) {
+    constexpr auto metadata = T::DefineMemberMapping();
+    if constexpr (isFixedWidth<T>) {
+        RequireBytes(input, fixedSize<T>); // One bounds check for the whole object
+        DecodeFixed(input.data(), object);
+        input.remove_prefix(fixedSize<T>);
+    }
+    else {
+        RequireBytes(input, presenceBytes<T>);
+        const auto bitmap = input.substr(0, presenceBytes<T>);
+        input.remove_prefix(presenceBytes<T>);
+
+        auto optionalIndex = std::size_t{ 0 };
+        auto DecodeElement = [&input, &object, bitmap, &optionalIndex](auto&& element) {
+            auto& value = object.*(element.member_);
+            using MEMBER = std::decay_t<decltype(value)>;
+            if constexpr (serializable::traits::isOptional<MEMBER>) {
+                const auto isPresent = (static_cast<unsigned char>(bitmap[optionalIndex / 8]) >> (optionalIndex % 8)) & 1;
+                ++optionalIndex;
+                if (!isPresent) {
+                    value.reset();
+                    return;
+                }
+                Decode(input, value.emplace());
+            }
+            else {
+                Decode(input, value);
+            }
+        };
+        std::apply([&DecodeElement](auto &&...element) { (DecodeElement(element), ...); }, metadata);
+        static_cast<void>(bitmap);
+    }
+}
+
+// Read one object from the front of the input, advancing past it. Strings are views into the input.
+template <class T> void Decode(std::string_view& input, T& object) {
+    if constexpr (isScalar<T>) {
+        RequireBytes(input, sizeof(T));
+        object = DecodeScalar<T>(input.data());
+        input.remove_prefix(sizeof(T));
+    }
+    else if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>) {
+        RequireBytes(input, sizeof(LengthPrefix));
+        const auto length = LoadLittleEndian<LengthPrefix>(input.data());
+        input.remove_prefix(sizeof(LengthPrefix));
+        RequireBytes(input, length);
+        object = T{ input.substr(0, length) };
+        input.remove_prefix(length);
+    }
+    else if constexpr (isFixedWidth<T>) {
+        RequireBytes(input, fixedSize<T>);
+        DecodeFixed(input.data(), object);
+        input.remove_prefix(fixedSize<T>);
+    }
+    else if constexpr (serializable::traits::isStdArray<T>) {
+        for (auto& element : object) { Decode(input, element); }
+    }
+    else if constexpr (serializable::traits::isContainer<T>) {
+        RequireBytes(input, sizeof(LengthPrefix));
+        const auto count = LoadLittleEndian<LengthPrefix>(input.data());
+        input.remove_prefix(sizeof(LengthPrefix));
+
+        object.clear();
+        if constexpr (serializable::traits::isVector<T>) {
+            object.reserve(std::min<std::size_t>(count, input.size())); // A corrupt count cannot over-allocate
+            for (auto i = LengthPrefix{ 0 }; i < count; ++i) { Decode(input, object.emplace_back()); }
+        }
+        else if constexpr (serializable::traits::isSet<T>) {
+            for (auto i = LengthPrefix{ 0 }; i < count; ++i) {
+                auto element = typename T::value_type{ };
+                Decode(input, element);
+                object.emplace_hint(object.end(), std::move(element)); // Written in order
+            }
+        }
+        else {
+            for (auto i = LengthPrefix{ 0 }; i < count; ++i) {
+                auto key = typename T::key_type{ };
+                Decode(input, key);
+                Decode(input, object.emplace_hint(object.end(), std::move(key), typename T::mapped_type{ })->second);
+            }
+        }
+    }
+    else {
+        DecodeFromMetadata(input, object);
+    }
+}
+
+} // namespace binary
+
+///////////////////////
+
+// Append binary encoding of a mapped object, growing the buffer exactly once
+template <class T> void serializeBinaryFromMetadata(std::string& output, const T& object) {
+    const auto offset = output.size();
+    output.resize(offset + binary::EncodedSizeFromMetadata(object));
+    auto* cursor = &output[0] + offset;
+    binary::EncodeFromMetadata(cursor, object);
+}
+
+// Decode one object from the front of the input, advancing the input past it
+template <class T> T DeserializeBinaryFromMetadata(std::string_view& input) {
+    auto result = T{ };
+    binary::DecodeFromMetadata(input, result);
+    return result;
+}
+
+template <class T> struct BINARY_SERIALIZATION {
+    [[nodiscard]] std::string serializeBinary() const {
+        auto result = std::string{ };
+        serializeBinaryFromMetadata(result, static_cast<const T&>(*this));
+        return result;
+    }
+
+    // Append binary output to an existing buffer
+    void serializeBinaryInto(std::string& output) const {
+        serializeBinaryFromMetadata(output, static_cast<const T&>(*this));
+    }
+
+    // Exact length of serializeBinary() output
+    [[nodiscard]] std::size_t binarySize() const {
+        return binary::EncodedSizeFromMetadata(static_cast<const T&>(*this));
+    }
+
+    [[nodiscard]] static T deserializeBinary(std::string_view input) {
+        static_assert(std::is_default_constructible_v<T>);
+        auto result = DeserializeBinaryFromMetadata<T>(input);
+        if (!input.empty()) { throw std::runtime_error{ "Error parsing binary: trailing bytes." }; }
+        return result;
+    }
+
+private:
+    friend T;
+    BINARY_SERIALIZATION() = default; // Protect against mismatched inheritance
+};
+
+#endif // !SERIAL_BINARY_CRTP_HPP
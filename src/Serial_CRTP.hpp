@@ -4,9 +4,19 @@
 #include <array>
 #include <charconv>
 #include <iostream>
+#include <iterator>
+#include <limits>
 #include <string>
 #include <string_view>
 #include <tuple>
+#include "Serial_Arena.hpp"
+#include "Serial_Escape.hpp"
+#include "Serial_Fingerprint.hpp"
+#include "Serial_Instrumentation.hpp"
+#include "Serial_Key_Index.hpp"
+#include "Serial_Member_Runs.hpp"
+#include "Serial_Number.hpp"
+#include "Serial_Structural_Index.hpp"
 #include "Serial_Type_Traits.hpp"
 #include "Utilities_Limited_Constexpr.hpp"
 #include <algorithm>
@@ -29,6 +39,8 @@ constexpr BINDING<M, T> MakeBinding(M T::* member, std::string_view name) {
 template <class T> struct LEXICOGRAPHICAL_EQUALITY {
     // Build lexigraphical equality operator from serialization metadata
     friend constexpr bool operator==(const T& lhs, const T& rhs) {
+        if (!limited_constexpr::IsConstantEvaluated()) { return member_runs::Equal(lhs, rhs); } // Runs of adjacent integral members compare as one memcmp
+
         auto CompareProperty = [&lhs, &rhs](auto &&...metadata) -> bool {
             return ((lhs.*metadata.member_ == rhs.*metadata.member_) && ...);
             };
@@ -44,10 +56,55 @@ private:
     LEXICOGRAPHICAL_EQUALITY() = default; // Protect against mismatched inheritance
 };
 
+template <class T> struct LEXICOGRAPHICAL_ORDERING {
+    // Three-way comparison in mapping order: negative, zero or positive as lhs orders before, equivalent to, or after rhs
+    friend constexpr int compare(const T& lhs, const T& rhs) {
+        if (!limited_constexpr::IsConstantEvaluated()) { return member_runs::Compare(lhs, rhs); } // Equal runs of adjacent integral members are skipped with one memcmp
+        return member_runs::CompareMemberwise(lhs, rhs);
+    }
+
+    friend constexpr bool operator<(const T& lhs, const T& rhs) { return compare(lhs, rhs) < 0; }
+    friend constexpr bool operator>(const T& lhs, const T& rhs) { return compare(lhs, rhs) > 0; }
+    friend constexpr bool operator<=(const T& lhs, const T& rhs) { return compare(lhs, rhs) <= 0; }
+    friend constexpr bool operator>=(const T& lhs, const T& rhs) { return compare(lhs, rhs) >= 0; }
+
+private:
+    friend T;
+    LEXICOGRAPHICAL_ORDERING() = default; // Protect against mismatched inheritance
+};
+
+template <class T> struct MEMBERWISE_HASH {
+    // Hash of the mapped members, consistent with LEXICOGRAPHICAL_EQUALITY
+    [[nodiscard]] std::size_t hash() const {
+        return static_cast<std::size_t>(member_runs::Hash(static_cast<const T&>(*this), 0));
+    }
+
+private:
+    friend T;
+    MEMBERWISE_HASH() = default; // Protect against mismatched inheritance
+};
+
+// Hasher for unordered containers keyed by mapped types, e.g. std::unordered_set<FOO, MemberwiseHash>
+struct MemberwiseHash {
+    template <class T> std::size_t operator()(const T& object) const {
+        return static_cast<std::size_t>(member_runs::Hash(object, 0));
+    }
+};
+
 ///////////////////////
 
-std::string ToString(int x) { // Cannot be constexpr until C++20
-    return std::to_string(x);
+// Append the text form of a number (integers, bool, float, double) without allocating
+template <class OUTPUT, class NUMBER> constexpr void AppendNumber(OUTPUT& output, NUMBER value) {
+    char buffer[number::maxChars<NUMBER>]{ };
+    const auto* end = number::ToChars(std::begin(buffer), value);
+    output.append(std::string_view{ buffer, static_cast<std::size_t>(end - std::begin(buffer)) });
+}
+
+template <class NUMBER, std::enable_if_t<number::isNumber<NUMBER>, int> = 0>
+constexpr limited_constexpr::FixedString<number::maxChars<NUMBER>> ToString(NUMBER value) {
+    auto result = limited_constexpr::FixedString<number::maxChars<NUMBER>>{ };
+    AppendNumber(result, value);
+    return result;
 }
 
 constexpr std::string_view ToString(std::string_view sv) {
@@ -58,166 +115,677 @@ constexpr std::string_view ToString(const char& c) {
     return { &c, 1 };
 }
 
-template <size_t N>
-std::string serializeFromArray(const std::array<std::pair<std::string, std::string>, N>& segmentedInput) {
-    auto result = std::string{ "{\n" };
-    auto ConcatenateElement = [&result](const std::pair<std::string, std::string> &pair) {
-        if (pair.second.empty()) {
-            return; // Omit/skip null values
+template <class OUTPUT, class T> constexpr void serializeFromMetadata(OUTPUT& output, const T& object);
+
+// Append the textual form of a single value; appends nothing for null values (e.g. empty optionals).
+// OUTPUT is std::string, or limited_constexpr::FixedString to serialize in constant expressions.
+template <class OUTPUT, class T> constexpr void serializeInternal(OUTPUT& output, const T& object) {
+    using namespace serializable::traits;
+    using TYPE = std::decay_t<T>;
+
+    if constexpr (isOptional<TYPE>) {
+        if (object.has_value()) { serializeInternal(output, object.value()); }
+    }
+    else if constexpr (isContainer<TYPE>) {
+        // "[count : element, element]", or "[0]" when empty. The count leads so readers can size the destination up front.
+        output.push_back('[');
+        AppendNumber(output, object.size());
+        auto separator = std::string_view{ " : " };
+        for (const auto& element : object) {
+            output.append(separator);
+            separator = ", ";
+            if constexpr (isMap<TYPE>) {
+                serializeInternal(output, element.first);
+                output.append(" : ");
+                serializeInternal(output, element.second);
+            }
+            else {
+                serializeInternal(output, element);
+            }
         }
-        result.push_back('\t');
-        result.append(pair.first);
-        result.append(" : ");
-        result.append(pair.second);
-        result.append(",\n");
-    };
+        output.push_back(']');
+    }
+    else if constexpr (std::is_enum_v<TYPE>) {
+        serializeInternal(output, static_cast<std::underlying_type_t<TYPE>>(object));
+    }
+    else if constexpr (hasSerializationInterface<TYPE> && hasMemberMapping<TYPE>) {
+        serializeFromMetadata(output, object); // Nested objects are written in place
+    }
+    else if constexpr (hasSerializeIntoInterface<TYPE>) {
+        object.serializeInto(output);
+    }
+    else if constexpr (hasSerializationInterface<TYPE>) {
+        output.append(object.serialize());
+    }
+    else if constexpr (number::isNumber<TYPE>) {
+        AppendNumber(output, object);
+    }
+    else if constexpr (escape::isText<TYPE>) {
+        escape::AppendEscaped(output, ToString(object)); // Delimiters inside values are escaped
+    }
+    else {
+        output.append(ToString(object));
+    }
+}
 
-    std::for_each(segmentedInput.begin(), segmentedInput.end(), ConcatenateElement);
+// Append serialized object to the output buffer. Each field is written in place: no intermediate strings.
+template <class OUTPUT, class T> constexpr void serializeFromMetadata(OUTPUT& output, const T& object) {
+    constexpr auto metadata = T::DefineMemberMapping(); // Create this separately to elide runtime call
+    output.append("{\n");
+
+    auto anyWritten = false;
+    auto AppendIfNotNull = [&output, &object, &anyWritten](auto&& element) {
+        const auto lineBegin = output.size();
+        if (anyWritten) { output.append(",\n"); } // Separators precede fields, so no trailing comma needs removing
+        output.push_back('\t');
+        output.append(element.name_);
+        output.append(" : ");
+        const auto valueBegin = output.size();
+        serializeInternal(output, object.*(element.member_));
+        if (output.size() == valueBegin) {
+            output.resize(lineBegin); // Omit/skip null values: roll back key
+            instrumentation::CountNullOmitted<T>();
+            return;
+        }
+        anyWritten = true;
+    };
+    std::apply([&AppendIfNotNull](auto &&...element) { (AppendIfNotNull(element), ...); }, metadata);
 
-    auto maybeComma = result.end() - 2;
-    if (maybeComma > result.begin()) { result.erase(maybeComma); }
-    result.push_back('}');
+    if (anyWritten) { output.push_back('\n'); }
+    output.push_back('}');
+}
 
-    return result;
+// Append an object preceded by its schema fingerprint. Every field is written in mapping order, null values included (with an empty value),
+// so a reader with the same fingerprint finds each field at its position; other readers skip the header and read by key as usual.
+template <class OUTPUT, class T> constexpr void serializeFingerprintedFromMetadata(OUTPUT& output, const T& object) {
+    constexpr auto metadata = T::DefineMemberMapping(); // Create this separately to elide runtime call
+    output.push_back('{');
+    output.append(fingerprint::header<T>);
+    auto AppendField = [&output, &object](auto&& element) {
+        output.append(",\n\t");
+        output.append(element.name_);
+        output.append(" : ");
+        serializeInternal(output, object.*(element.member_));
+    };
+    std::apply([&AppendField](auto &&...element) { (AppendField(element), ...); }, metadata);
+    output.append("\n}");
 }
 
-template <class T> std::string serializeInternal(const T& object) {
+///////////////////////
+
+// Exact number of characters serializeInternal() will append for a single value; zero for null values
+template <class T> constexpr std::size_t serializedSizeInternal(const T& object) {
     using namespace serializable::traits;
     using TYPE = std::decay_t<T>;
 
     if constexpr (isOptional<TYPE>) {
-        using ValueType = typename TYPE::value_type;
-        return object.has_value() ? serializeInternal<ValueType>(object.value()) : std::string{};
+        return object.has_value() ? serializedSizeInternal(object.value()) : 0;
+    }
+    else if constexpr (isContainer<TYPE>) {
+        auto size = 2 + number::ToCharsLength(object.size()); // '[', count, ']'
+        auto separatorSize = std::size_t{ 3 }; // " : " before the first element, ", " before the others
+        for (const auto& element : object) {
+            size += separatorSize;
+            separatorSize = 2;
+            if constexpr (isMap<TYPE>) {
+                size += serializedSizeInternal(element.first) + 3 + serializedSizeInternal(element.second);
+            }
+            else {
+                size += serializedSizeInternal(element);
+            }
+        }
+        return size;
     }
-    /// @todo Add cases for several standard containers
     else if constexpr (std::is_enum_v<TYPE>) {
-        return ToString(static_cast<std::underlying_type_t<TYPE>>(object));
+        return serializedSizeInternal(static_cast<std::underlying_type_t<TYPE>>(object));
+    }
+    else if constexpr (hasSerializedSizeInterface<TYPE>) {
+        return object.serializedSize();
     }
     else if constexpr (hasSerializationInterface<TYPE>) {
-        return object.serialize();
+        return object.serialize().size();
+    }
+    else if constexpr (number::isInteger<TYPE>) {
+        return number::ToCharsLength(object);
+    }
+    else if constexpr (escape::isText<TYPE>) {
+        return escape::EscapedSize(ToString(object));
     }
     else {
-        return std::string{ ToString(object) };
+        return ToString(object).size();
     }
 }
 
-template <class T> std::string serializeFromMetadata(const T& object) {
-    auto result = std::string{ "{\n" };
+// Exact length of serializeFromMetadata() output, mirroring its layout: "{\n", "\tkey : value,\n" per non-null field, "}"
+template <class T> constexpr std::size_t serializedSizeFromMetadata(const T& object) {
     constexpr auto metadata = T::DefineMemberMapping(); // Create this separately to elide runtime call
-    auto lines = std::array<std::pair<std::string, std::string>, std::tuple_size_v<decltype(metadata)>>{ };
-
-    // Fill array with key names for lookup
-    auto index = 0;
-    auto InsertKey = [&result, &lines, &index](auto &&...element) {
-        ((lines[index++].first = element.name_), ...);
+    auto size = std::size_t{ 3 }; // "{\n" & "}"
+    auto anyWritten = false;
+    auto AddIfNotNull = [&size, &object, &anyWritten](auto&& element) {
+        const auto valueSize = serializedSizeInternal(object.*(element.member_));
+        if (valueSize == 0) { return; } // Null values are omitted
+        size += 1 + element.name_.size() + 3 + valueSize + 2; // '\t', key, " : ", value, ",\n"
+        anyWritten = true;
     };
-    std::apply(InsertKey, metadata);
-
-    auto AssignProperty = [&lines, &object](auto &&...element) {
-        auto AddIfNotNull = [&lines, &object](auto&& element) {
-            auto j = serializeInternal((object.*(element.member_)));
-            if (!j.empty()) {
-                auto matchKey = [key = element.name_.data()](const std::pair<std::string_view, std::string_view>& keyValuePair) {
-                    return keyValuePair.first == key;
-                };
-                auto location = lines.begin();
-                while (location != lines.end() && !matchKey(*location)) { ++location; } // std::find_if() is not constexpr until C++20
-                if (location != lines.end()) { location->second = std::move(j); }
-            }
-        };
-        (AddIfNotNull(element), ...);
-        static_cast<void>(AddIfNotNull);
+    std::apply([&AddIfNotNull](auto &&...element) { (AddIfNotNull(element), ...); }, metadata);
+    return anyWritten ? size - 1 : size; // Trailing comma is dropped
+}
+
+// Sentinel for values without a fixed upper bound on their serialized length (e.g. strings)
+inline constexpr std::size_t unboundedSerializedSize = std::numeric_limits<std::size_t>::max();
+
+template <class T> constexpr std::size_t maxSerializedSizeFromMetadata();
+
+// Compile-time upper bound on the serialized length of a value of type T
+template <class T> constexpr std::size_t maxSerializedSizeInternal() {
+    using namespace serializable::traits;
+    using TYPE = std::decay_t<T>;
+
+    if constexpr (isOptional<TYPE>) {
+        return maxSerializedSizeInternal<typename TYPE::value_type>();
+    }
+    else if constexpr (isStdArray<TYPE>) {
+        constexpr auto count = std::tuple_size_v<TYPE>;
+        constexpr auto elementSize = maxSerializedSizeInternal<typename TYPE::value_type>();
+        constexpr auto prefixSize = 2 + number::ToCharsLength(count); // '[', count, ']'
+        if constexpr (count == 0) { return prefixSize; }
+        else if constexpr (elementSize == unboundedSerializedSize) { return unboundedSerializedSize; }
+        else { return prefixSize + 3 + count * elementSize + 2 * (count - 1); } // " : " then ", " between elements
+    }
+    else if constexpr (std::is_enum_v<TYPE>) {
+        return maxSerializedSizeInternal<std::underlying_type_t<TYPE>>();
+    }
+    else if constexpr (hasSerializationInterface<TYPE> && hasMemberMapping<TYPE>) {
+        return maxSerializedSizeFromMetadata<TYPE>();
+    }
+    else if constexpr (number::isNumber<TYPE>) {
+        return number::maxChars<TYPE>;
+    }
+    else if constexpr (std::is_same_v<TYPE, char>) {
+        return 2; // Possibly escaped
+    }
+    else {
+        return unboundedSerializedSize;
+    }
+}
+
+// Upper bound on serializeFromMetadata() output, assuming every field is present
+template <class T> constexpr std::size_t maxSerializedSizeFromMetadata() {
+    constexpr auto metadata = T::DefineMemberMapping(); // Create this separately to elide runtime call
+    auto size = std::size_t{ 3 }; // "{\n" & "}"
+    auto AddField = [&size](auto&& element) {
+        using MEMBER = std::decay_t<decltype(std::declval<T>().*(element.member_))>;
+        constexpr auto valueSize = maxSerializedSizeInternal<MEMBER>();
+        if (size == unboundedSerializedSize || valueSize == unboundedSerializedSize) {
+            size = unboundedSerializedSize;
+            return;
+        }
+        size += 1 + element.name_.size() + 3 + valueSize + 2; // '\t', key, " : ", value, ",\n"
     };
+    std::apply([&AddField](auto &&...element) { (AddField(element), ...); }, metadata);
+    if (size == unboundedSerializedSize || std::tuple_size_v<decltype(metadata)> == 0) { return size; }
+    return size - 1; // Trailing comma is dropped
+}
+
+template <class T> std::string serializeFromMetadata(const T& object) {
+    return instrumentation::Instrumented<T>(instrumentation::Operation::serialize, [&object] {
+        auto result = std::string{ };
+        result.reserve(serializedSizeFromMetadata(object)); // Allocate exactly once
+        serializeFromMetadata(result, object);
+        return result;
+    }, [](const std::string& result) { return result.size(); });
+}
+
+// Serialize into a fixed-capacity string, in constant expressions as well; exceeding CAPACITY throws std::length_error
+template <std::size_t CAPACITY, class T> constexpr limited_constexpr::FixedString<CAPACITY> serializeToFixedString(const T& object) {
+    auto result = limited_constexpr::FixedString<CAPACITY>{ };
+    serializeFromMetadata(result, object);
+    return result;
+}
+
+template <class T> constexpr std::size_t MaxKeyPrefixSize();
+
+template <class T> constexpr std::size_t MaxNestedKeyPrefixSize() {
+    using namespace serializable::traits;
 
-    std::apply(AssignProperty, metadata);
-    return serializeFromArray(lines);
+    if constexpr (isOptional<T>) { return MaxNestedKeyPrefixSize<typename T::value_type>(); }
+    else if constexpr (isMap<T>) { return std::max(MaxNestedKeyPrefixSize<typename T::key_type>(), MaxNestedKeyPrefixSize<typename T::mapped_type>()); }
+    else if constexpr (isContainer<T>) { return MaxNestedKeyPrefixSize<typename T::value_type>(); }
+    else if constexpr (hasMemberMapping<T>) { return MaxKeyPrefixSize<T>(); }
+    else { return 0; }
 }
 
+// Longest ",\n\tkey : " written by T or any object nested in it: the most a null field occupies before being rolled back
+template <class T> constexpr std::size_t MaxKeyPrefixSize() {
+    return std::apply([](auto &&...element) {
+        auto size = std::size_t{ 0 };
+        ((size = std::max({ size, 3 + element.name_.size() + 3, MaxNestedKeyPrefixSize<std::decay_t<decltype(std::declval<T>().*(element.member_))>>() })), ...);
+        return size;
+        }, T::DefineMemberMapping());
+}
+
+// Exact-size character array holding the serialized form of a constant, without a terminating null
+template <const auto& OBJECT> constexpr auto SerializeToArray() {
+    using TYPE = std::decay_t<decltype(OBJECT)>;
+    constexpr auto size = serializedSizeFromMetadata(OBJECT); // Exact, including compile-time digit counts
+    const auto text = serializeToFixedString<size + MaxKeyPrefixSize<TYPE>()>(OBJECT);
+    auto result = std::array<char, size>{ };
+    for (auto i = std::size_t{ 0 }; i < size; ++i) { result[i] = text[i]; }
+    return result;
+}
+
+// Serialized form of a constant, produced during compilation and stored in read-only data: no runtime formatting or allocation
+template <const auto& OBJECT>
+inline constexpr auto serializedArray = SerializeToArray<OBJECT>();
+
+template <const auto& OBJECT>
+inline constexpr auto serializedConstant = std::string_view{ serializedArray<OBJECT>.data(), serializedArray<OBJECT>.size() };
+
 ///////////////////////
 
+// Provide a static interface; numbers are handled here, other types by specialization
 template <class T>
-constexpr T FromStringView(std::string_view sv); // Provide a static interface
+constexpr T FromStringView(std::string_view sv) {
+    static_assert(number::isNumber<T>, "Specialize FromStringView to deserialize this type");
+    const auto tentativeValue = number::FromChars<T>(sv.data(), sv.data() + sv.size());
+    if (!tentativeValue.has_value()) { throw std::runtime_error{ "Error parsing number." }; }
+    return tentativeValue.value();
+}
 
+// Views refer into the input unless the text is escaped; escaped text can only be viewed once unescaped into an arena
 template <>
 constexpr std::string_view FromStringView(std::string_view sv) {
-    return sv;
+    if (!escape::IsEscaped(sv)) {
+        if (limited_constexpr::IsConstantEvaluated()) { return sv; }
+        return arena::Retain(sv); // Copied into the arena, if any, so the result outlives the input
+    }
+    if (limited_constexpr::IsConstantEvaluated()) { throw std::runtime_error{ "Error parsing string: escaped text cannot be viewed in constant expressions." }; }
+    const auto unescaped = escape::RetainUnescaped(sv);
+    if (!unescaped.has_value()) { throw std::runtime_error{ "Error parsing string: malformed escape sequence, or escaped text viewed outside an arena." }; }
+    return *unescaped;
+}
+
+template <class STRING> STRING UnescapedString(std::string_view sv, STRING result) {
+    if (!escape::AssignUnescaped(result, sv)) { throw std::runtime_error{ "Error parsing string: malformed escape sequence." }; }
+    return result;
 }
 
 template <>
-constexpr int FromStringView(std::string_view sv) {
-    auto tentativeValue = limited_constexpr::FromChars<int>(sv.data(), sv.data() + sv.size());
-    if (!tentativeValue.has_value()) { throw std::runtime_error{ "Error parsing int." }; }
-    return tentativeValue.value();
+inline std::string FromStringView(std::string_view sv) { // Cannot be constexpr until C++20
+    return UnescapedString(sv, std::string{ });
+}
 
-    /// @todo Make constexpr version of std::from_chars, even if limited
-    //auto result = int{};
-    //auto retCode = std::from_chars(sv.data(), sv.data() + sv.size(), result);
-    //if (retCode.ec == std::errc{}) { return result; }
-    //else { 
-    //    throw std::runtime_error{ "Error parsing int." };
-    //}
+template <>
+inline std::pmr::string FromStringView(std::string_view sv) {
+    return UnescapedString(sv, std::pmr::string{ arena::Resource() });
 }
 
 template <>
 constexpr char FromStringView(std::string_view sv) {
-    return sv.at(0);
+    const auto c = escape::UnescapeChar(sv);
+    if (!c.has_value()) { throw std::runtime_error{ "Error parsing char: expected a single character." }; }
+    return *c;
 }
 
 constexpr bool IsWhitespace(char c) {
     return c == '\n' || c == '\t';
 }
 
-template <class T> constexpr T DeserializeFromMetadata(std::string_view input) {
-    auto result = T{ };
-    constexpr auto list = T::DefineMemberMapping(); // Create this separately to elide runtime call
-    auto lines = std::array<std::pair<std::string_view, std::string_view>, std::tuple_size_v<decltype(list)>>{ };
+// Strip surrounding whitespace and spaces, e.g. around container elements
+constexpr std::string_view TrimWhitespace(std::string_view sv) {
+    while (!sv.empty() && (IsWhitespace(sv.front()) || sv.front() == ' ')) { sv.remove_prefix(1); }
+    while (!sv.empty() && (IsWhitespace(sv.back()) || sv.back() == ' ')) { sv.remove_suffix(1); }
+    return sv;
+}
 
-    // Fill array with key names for lookup
-    auto index = 0;
-    auto InsertKey = [&result, &lines, &index](auto &&...element) {
-        ((lines[index++].first = element.name_), ...);
-    };
-    std::apply(InsertKey, list);
+// Position of the first 'target' at or after 'pos' which is not inside a nested object or container; input size if none
+constexpr std::size_t FindUnnested(std::string_view input, std::size_t pos, char target) {
+    // Flat values are common: memchr-style searches settle them without a byte-wise walk
+    const auto candidate = std::min(input.find(target, pos), input.size());
+    if (pos >= candidate) { return candidate; }
+    const auto before = input.substr(pos, candidate - pos);
+    if (before.find('{') == std::string_view::npos && before.find('[') == std::string_view::npos) { return candidate; }
+
+    auto depth = std::size_t{ 0 };
+    for (; pos < input.size(); ++pos) {
+        const auto c = input[pos];
+        if (c == '{' || c == '[') { ++depth; }
+        else if ((c == '}' || c == ']') && depth > 0) { --depth; }
+        else if (c == target && depth == 0) { return pos; }
+    }
+    return input.size();
+}
 
-    input.remove_prefix(1); // '{'
-    input.remove_suffix(1); // '}'
+// Scalar scanning, usable in constant expressions
+class ScalarScanner {
+public:
+    constexpr explicit ScalarScanner(std::string_view input) : input_{ input } {}
+
+    constexpr std::size_t skipWhitespace(std::size_t pos) const {
+        while (pos < input_.size() && IsWhitespace(input_[pos])) { ++pos; }
+        return pos;
+    }
+
+    constexpr std::size_t findColon(std::size_t pos) const {
+        return std::min(input_.find(':', pos), input_.size()); // std::string_view::npos will always exceed size
+    }
+
+    // Position of the ',' closing the value beginning at 'pos', skipping over any nested objects & containers; input size if none
+    constexpr std::size_t findValueEnd(std::size_t pos) const {
+        return FindUnnested(input_, pos, ',');
+    }
+
+private:
+    std::string_view input_;
+};
+
+// Vectorized scanning: walks the structural character bitmasks built by the SIMD pre-pass
+class IndexedScanner {
+public:
+    explicit IndexedScanner(std::string_view input) : input_{ input }, cursor_{ input } {}
+
+    std::size_t skipWhitespace(std::size_t pos) { return cursor_.skipWhitespace(pos); }
+
+    std::size_t findColon(std::size_t pos) {
+        pos = cursor_.nextStructural(pos);
+        while (pos < input_.size() && input_[pos] != ':') { pos = cursor_.nextStructural(pos + 1); }
+        return pos;
+    }
+
+    std::size_t findValueEnd(std::size_t pos) {
+        auto depth = std::size_t{ 0 };
+        for (pos = cursor_.nextStructural(pos); pos < input_.size(); pos = cursor_.nextStructural(pos + 1)) {
+            const auto c = input_[pos];
+            if (c == '{' || c == '[') { ++depth; }
+            else if ((c == '}' || c == ']') && depth > 0) { --depth; }
+            else if (c == ',' && depth == 0) { return pos; }
+        }
+        return input_.size();
+    }
+
+private:
+    std::string_view input_;
+    structural::StructuralCursor cursor_;
+};
 
-    // Parse key-value pairs, match values to keys assigned above, discard any unrecognized keys
+// Split the body of an object (braces removed) into key & value sub-views, handing each pair to the visitor
+template <class SCANNER, class VISITOR> constexpr void ForEachKeyValue(std::string_view input, SCANNER&& scanner, VISITOR&& visit) {
     auto keyBeginPos = size_t{ 0 };
     while (keyBeginPos < input.size()) {
         // Identify important positional values to split line into key & value sub-views
-        while (keyBeginPos < input.size() && IsWhitespace(input[keyBeginPos])) { ++keyBeginPos; } // Trim preceeding whitespace
-        auto colonPos = input.find(':', keyBeginPos);
+        keyBeginPos = scanner.skipWhitespace(keyBeginPos); // Trim preceeding whitespace
+        auto colonPos = scanner.findColon(keyBeginPos);
+        if (colonPos >= input.size()) { break; } // Only whitespace remains
         auto valueBeginPos = colonPos + 2; // Advance past ':' and ' '
-        auto endPos = input.find(',', colonPos);
-        endPos = std::min(endPos, input.size()); // std::string_view::npos will always exceed size
+        auto endPos = scanner.findValueEnd(valueBeginPos); // Nested objects & containers may contain ','
 
         // Identify key and value
         auto key = input.substr(keyBeginPos, colonPos - keyBeginPos - 1);
         auto value = input.substr(valueBeginPos, endPos - valueBeginPos);
         while (!value.empty() && IsWhitespace(value.back())) { value.remove_suffix(1); } // Trim trailing whitespace
 
-        // Assign value alongside associated key if it exists; skip unrecognized keys
-        auto matchKey = [key](const std::pair<std::string_view, std::string_view>& keyValuePair) {
-            return keyValuePair.first == key;
-        };
-        auto location = lines.begin();
-        while (location != lines.end() && !matchKey(*location)) { ++location; } // std::find_if() is not constexpr until C++20
-        if (location != lines.end()) { location->second = value; }
-
+        visit(key, value);
         keyBeginPos = endPos + 1; // Set next iteration start point
     }
+}
+
+// Runtime entry point for the vectorized splitter; kept out of line from constexpr callers
+template <class VISITOR> void ForEachKeyValueIndexed(std::string_view input, VISITOR&& visit) {
+    ForEachKeyValue(input, IndexedScanner{ input }, visit);
+}
+
+template <class T> constexpr T deserializeInternal(std::string_view value);
+template <class T> constexpr T DeserializeFromMetadata(std::string_view input);
+
+// Element count and element list of a container written as "[count : element, element]"
+struct ContainerText {
+    std::size_t count{ 0 };
+    std::string_view elements{ };
+};
+
+constexpr ContainerText SplitContainer(std::string_view value) {
+    if (value.size() < 3 || value.front() != '[' || value.back() != ']') { throw std::runtime_error{ "Error parsing container." }; }
+    value = value.substr(1, value.size() - 2);
+    const auto countEnd = std::min(value.find(' '), value.size());
+    const auto tentativeCount = number::FromChars<std::size_t>(value.data(), value.data() + countEnd);
+    if (!tentativeCount.has_value()) { throw std::runtime_error{ "Error parsing container: missing element count." }; }
+    const auto count = tentativeCount.value();
+    auto elements = value.substr(countEnd);
+    if (count == 0 ? !elements.empty() : elements.substr(0, 3) != " : ") { throw std::runtime_error{ "Error parsing container." }; }
+    elements.remove_prefix(std::min(elements.size(), std::size_t{ 3 }));
+    return { count, elements };
+}
+
+// Most elements the text of a container can hold. Elements may be empty (empty strings, null optionals), but each one after the first
+// is preceded by a ',', so a corrupt count cannot over-allocate
+constexpr std::size_t MaxElementCount(std::string_view elements) {
+    return elements.size() + 1;
+}
+
+// Hand each element to the visitor in order, along with its index; map entries are passed whole
+template <class VISITOR> constexpr void ForEachElement(const ContainerText& container, VISITOR&& visit) {
+    const auto elements = container.elements;
+    auto pos = std::size_t{ 0 };
+    for (auto index = std::size_t{ 0 }; index < container.count; ++index) {
+        if (pos > elements.size()) { throw std::runtime_error{ "Error parsing container: fewer elements than counted." }; }
+        const auto endPos = FindUnnested(elements, pos, ',');
+        visit(index, TrimWhitespace(elements.substr(pos, endPos - pos)));
+        pos = endPos + 1;
+    }
+    if (container.count != 0 && pos != elements.size() + 1) { throw std::runtime_error{ "Error parsing container: more elements than counted." }; }
+}
+
+// Key & value of a map entry written as "key : value"
+constexpr std::pair<std::string_view, std::string_view> SplitMapEntry(std::string_view element) {
+    const auto colonPos = FindUnnested(element, 0, ':');
+    if (colonPos >= element.size()) { throw std::runtime_error{ "Error parsing container: map entry without a key." }; }
+    return { TrimWhitespace(element.substr(0, colonPos)), TrimWhitespace(element.substr(colonPos + 1)) };
+}
+
+// Interpret "[count : element, element]"; the count is read first so the destination is sized before any element is parsed
+template <class T> constexpr T DeserializeContainer(std::string_view value) {
+    using namespace serializable::traits;
+
+    const auto container = SplitContainer(value);
+    auto result = arena::MakeValue<T>();
+    if constexpr (isStdArray<T>) {
+        if (container.count != result.size()) { throw std::runtime_error{ "Error parsing container: element count does not match std::array size." }; }
+    }
+    else if constexpr (isVector<T>) {
+        result.reserve(std::min(container.count, MaxElementCount(container.elements)));
+    }
+
+    ForEachElement(container, [&result](std::size_t index, std::string_view element) {
+        if constexpr (isStdArray<T>) {
+            arena::Assign(result[index], deserializeInternal<typename T::value_type>(element));
+        }
+        else if constexpr (isVector<T>) {
+            result.push_back(deserializeInternal<typename T::value_type>(element));
+        }
+        else if constexpr (isSet<T>) {
+            result.emplace_hint(result.end(), deserializeInternal<typename T::value_type>(element)); // Written in order
+        }
+        else {
+            const auto [key, mapped] = SplitMapEntry(element);
+            result.emplace_hint(result.end(), deserializeInternal<typename T::key_type>(key), deserializeInternal<typename T::mapped_type>(mapped));
+        }
+    });
+    return result;
+}
+
+// Interpret the textual form of a single value; the counterpart of serializeInternal()
+template <class T> constexpr T deserializeInternal(std::string_view value) {
+    using namespace serializable::traits;
+
+    if constexpr (isOptional<T>) {
+        if (value.empty()) { return std::nullopt; } // Null values are omitted
+        return deserializeInternal<typename T::value_type>(value);
+    }
+    else if constexpr (isContainer<T>) {
+        return DeserializeContainer<T>(value);
+    }
+    else if constexpr (std::is_enum_v<T>) {
+        return static_cast<T>(deserializeInternal<std::underlying_type_t<T>>(value));
+    }
+    else if constexpr (hasSerializationInterface<T> && hasMemberMapping<T>) {
+        return DeserializeFromMetadata<T>(value); // Nested objects are part of the enclosing call, not top-level calls of their own
+    }
+    else if constexpr (hasSerializationInterface<T>) {
+        return T::deserialize(value);
+    }
+    else {
+        return FromStringView<T>(value);
+    }
+}
+
+// Parse the key-value pairs of an object (braces removed), handing each value of a recognized key to the visitor along with
+// the mapping index of its binding; unrecognized keys are discarded
+template <class T, class VISITOR> constexpr void ForEachMappedValue(std::string_view body, VISITOR&& visit) {
+    auto VisitMapped = [&visit](std::string_view key, std::string_view value) {
+        const auto index = keyIndex<T>.find(key); // Compile-time perfect hash: O(1) regardless of field count
+        if (index != keyIndex<T>.npos) { visit(index, value); }
+        else { instrumentation::CountUnknownKey<T>(); }
+    };
+    if (limited_constexpr::IsConstantEvaluated() || body.size() < structural::blockSize) {
+        ForEachKeyValue(body, ScalarScanner{ body }, VisitMapped); // Short records do not amortize a block scan
+    }
+    else {
+        ForEachKeyValueIndexed(body, VisitMapped); // SIMD structural scanning
+    }
+}
 
-    // Iterate over member variables and assign values assuming each name is present and in same order
+template <class T> constexpr void deserializeInternalInto(T& target, std::string_view value);
+
+// Overwrite a container element by element. Vectors are resized in place, so their capacity and that of surviving elements is kept;
+// set & map nodes are detached, refilled and relinked, so equally sized containers are refilled without allocating.
+template <class T> constexpr void DeserializeContainerInto(T& target, std::string_view value) {
+    using namespace serializable::traits;
+
+    const auto container = SplitContainer(value);
+    if constexpr (isStdArray<T>) {
+        if (container.count != target.size()) { throw std::runtime_error{ "Error parsing container: element count does not match std::array size." }; }
+        ForEachElement(container, [&target](std::size_t index, std::string_view element) { deserializeInternalInto(target[index], element); });
+    }
+    else if constexpr (isVector<T>) {
+        if (container.count > MaxElementCount(container.elements)) { throw std::runtime_error{ "Error parsing container: fewer elements than counted." }; }
+        target.resize(container.count);
+        ForEachElement(container, [&target](std::size_t index, std::string_view element) { deserializeInternalInto(target[index], element); });
+    }
+    else {
+        auto rebuilt = T(target.get_allocator()); // Node handles only move between containers sharing an allocator
+        ForEachElement(container, [&target, &rebuilt](std::size_t, std::string_view element) {
+            if (target.empty()) {
+                if constexpr (isSet<T>) {
+                    rebuilt.emplace_hint(rebuilt.end(), deserializeInternal<typename T::value_type>(element)); // Written in order
+                }
+                else {
+                    const auto [key, mapped] = SplitMapEntry(element);
+                    rebuilt.emplace_hint(rebuilt.end(), deserializeInternal<typename T::key_type>(key), deserializeInternal<typename T::mapped_type>(mapped));
+                }
+                return;
+            }
+
+            auto node = target.extract(target.begin());
+            if constexpr (isSet<T>) {
+                deserializeInternalInto(node.value(), element);
+            }
+            else {
+                const auto [key, mapped] = SplitMapEntry(element);
+                deserializeInternalInto(node.key(), key);
+                deserializeInternalInto(node.mapped(), mapped);
+            }
+            rebuilt.insert(rebuilt.end(), std::move(node));
+        });
+        target.swap(rebuilt); // Nodes left over are released with 'rebuilt'
+    }
+}
+
+// Decode the body of an object written by serializeFingerprintedFromMetadata() with T's own fingerprint: fields are taken in mapping order,
+// each key compared against the one expected at its position instead of being parsed and looked up
+template <class T> constexpr void DeserializePositionalInto(T& target, std::string_view body) {
+    constexpr auto list = T::DefineMemberMapping(); // Create this separately to elide runtime call
+    const auto scanner = ScalarScanner{ body };
+    auto pos = fingerprint::header<T>.size();
+    auto DeserializeField = [&target, body, &scanner, &pos](auto&& element) {
+        const auto valueBeginPos = pos + 3 + element.name_.size() + 3; // ",\n\t", key, " : "
+        if (valueBeginPos > body.size() || body.substr(pos, 3) != ",\n\t" || body.substr(pos + 3, element.name_.size()) != element.name_
+            || body.substr(valueBeginPos - 3, 3) != " : ") {
+            throw std::runtime_error{ "Error parsing object: fields do not match the schema fingerprint." };
+        }
+        const auto endPos = scanner.findValueEnd(valueBeginPos);
+        auto value = body.substr(valueBeginPos, endPos - valueBeginPos);
+        while (!value.empty() && IsWhitespace(value.back())) { value.remove_suffix(1); } // Trim trailing whitespace
+        deserializeInternalInto(target.*(element.member_), value);
+        pos = endPos;
+    };
+    std::apply([&DeserializeField](auto &&...element) { (DeserializeField(element), ...); }, list);
+    if (pos != body.size()) { throw std::runtime_error{ "Error parsing object: fields do not match the schema fingerprint." }; } // Fields past the last binding
+}
+
+// Overwrite the mapped members of an existing object from its serialized form, reusing the storage they already own
+template <class T> constexpr void DeserializeFromMetadataInto(T& target, std::string_view input) {
+    constexpr auto list = T::DefineMemberMapping(); // Create this separately to elide runtime call
+    auto values = std::array<std::string_view, std::tuple_size_v<decltype(list)>>{ }; // Indexed the same as the mapping
+
+    input.remove_prefix(1); // '{'
+    input.remove_suffix(1); // '}'
+
+    // Same schema as the writer: fields are where the mapping puts them
+    if (input.substr(0, fingerprint::header<T>.size()) == fingerprint::header<T>) {
+        DeserializePositionalInto(target, input);
+        return;
+    }
+
+    // Match values to keys assigned above
+    ForEachMappedValue<T>(input, [&values](std::size_t index, std::string_view value) { values[index] = value; });
+
+    // Iterate over member variables and assign values in mapping order; absent keys read as null, as in a fresh object
     auto counter = 0;
-    auto DeserializeElement = [&result, &lines, &counter](auto &&...element) {
-        ((result.*(element.member_) = FromStringView<std::decay_t<decltype(result.*(element.member_))>>(lines[counter++].second)), ...);
+    auto DeserializeElement = [&target, &values, &counter](auto &&...element) {
+        (deserializeInternalInto(target.*(element.member_), values[counter++]), ...);
     };
     std::apply(DeserializeElement, list);
+}
 
+template <class T> constexpr T DeserializeFromMetadata(std::string_view input) {
+    auto result = T{ };
+    DeserializeFromMetadataInto(result, input);
     return result;
 }
 
+// Overwrite a single value in place; the counterpart of deserializeInternal() for existing objects
+template <class T> constexpr void deserializeInternalInto(T& target, std::string_view value) {
+    using namespace serializable::traits;
+
+    if constexpr (arena::isAllocatorAware<T>) {
+        if (!arena::IsOn(target.get_allocator())) { // e.g. members of a fresh object decoded into an arena: build on the arena instead
+            arena::Assign(target, deserializeInternal<T>(value));
+            return;
+        }
+    }
+
+    if constexpr (isOptional<T>) {
+        if (value.empty()) {
+            target.reset(); // Null values are omitted
+            return;
+        }
+        if (!target.has_value()) { target.emplace(arena::MakeValue<typename T::value_type>()); } // Engaged payloads are reused
+        deserializeInternalInto(*target, value);
+    }
+    else if constexpr (isContainer<T>) {
+        DeserializeContainerInto(target, value);
+    }
+    else if constexpr (isString<T>) {
+        if (!escape::AssignUnescaped(target, value)) { throw std::runtime_error{ "Error parsing string: malformed escape sequence." }; } // Keeps capacity
+    }
+    else if constexpr (hasSerializationInterface<T> && hasMemberMapping<T>) {
+        DeserializeFromMetadataInto(target, value);
+    }
+    else {
+        arena::Assign(target, deserializeInternal<T>(value));
+    }
+}
+
 ///////////////////////
 
 template <class T> struct SERIALIZATION {
@@ -225,9 +793,67 @@ template <class T> struct SERIALIZATION {
         return serializeFromMetadata(static_cast<const T&>(*this));
     }
 
+    // Append serialized output to an existing buffer, e.g. to batch many records into one allocation
+    void serializeInto(std::string& output) const {
+        instrumentation::Instrumented<T>(instrumentation::Operation::serialize, [this, &output] {
+            const auto before = output.size();
+            serializeFromMetadata(output, static_cast<const T&>(*this));
+            return output.size() - before;
+        }, [](std::size_t appended) { return appended; });
+    }
+
+    // Exact length of serialize() output, e.g. to pre-size a buffer or frame
+    [[nodiscard]] constexpr std::size_t serializedSize() const {
+        return serializedSizeFromMetadata(static_cast<const T&>(*this));
+    }
+
+    // Compile-time upper bound on serialize() output; only available when every mapped member is fixed-width
+    [[nodiscard]] static constexpr std::size_t maxSerializedSize() {
+        constexpr auto size = maxSerializedSizeFromMetadata<T>();
+        static_assert(size != unboundedSerializedSize, "All mapped members must be fixed-width to bound serialized size");
+        return size;
+    }
+
+    // Serialize with a schema fingerprint header; readers built from the same schema decode it by position, any other reader by key
+    [[nodiscard]] std::string serializeFingerprinted() const {
+        auto result = std::string{ };
+        serializeFingerprintedInto(result);
+        return result;
+    }
+
+    void serializeFingerprintedInto(std::string& output) const {
+        instrumentation::Instrumented<T>(instrumentation::Operation::serialize, [this, &output] {
+            const auto before = output.size();
+            serializeFingerprintedFromMetadata(output, static_cast<const T&>(*this));
+            return output.size() - before;
+        }, [](std::size_t appended) { return appended; });
+    }
+
+    // Serialize into a fixed-capacity string of maxSerializedSize(); usable in constant expressions
+    [[nodiscard]] constexpr auto serializeFixed() const {
+        return serializeToFixedString<maxSerializedSize()>(static_cast<const T&>(*this));
+    }
+
     [[nodiscard]] static constexpr T deserialize(std::string_view input) {
         static_assert(std::is_default_constructible_v<T>);
-        return DeserializeFromMetadata<T>(input);
+        return instrumentation::Instrumented<T>(instrumentation::Operation::deserialize, [input] { return DeserializeFromMetadata<T>(input); },
+            [input](const T&) { return input.size(); });
+    }
+
+    // Overwrite an existing object field by field, keeping the storage its members already own: string & container capacity,
+    // engaged optionals and nested objects. Decoding into a reused object allocates nothing once its storage has grown to fit.
+    static constexpr void deserializeInto(T& target, std::string_view input) {
+        instrumentation::Instrumented<T>(instrumentation::Operation::deserialize, [&target, input] {
+            DeserializeFromMetadataInto(target, input);
+            return input.size();
+        }, [](std::size_t consumed) { return consumed; });
+    }
+
+    // Deserialize with all variable-length data (std::pmr strings & containers, copies of std::string_view values) allocated from 'resource',
+    // e.g. one std::pmr::monotonic_buffer_resource per batch of records. The result does not refer to 'input'.
+    [[nodiscard]] static T deserializeWith(std::string_view input, std::pmr::memory_resource* resource) {
+        const auto scope = arena::ScopedResource{ resource };
+        return deserialize(input);
     }
 
 private:
@@ -0,0 +1,301 @@
+#ifndef SERIAL_CHECKED_HPP
+#define SERIAL_CHECKED_HPP 1
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "Serial_CRTP.hpp"
+
+/// <summary>
+/// Deserialization for untrusted input which reports failure instead of throwing: tryDeserialize<T>() returns either the object
+/// or an error code with the byte offset in the input where decoding stopped. Every position is bounds-checked, including
+/// the braces and " : " separators the throwing path takes for granted, and reporting an error allocates nothing.
+/// Absent fields keep their default value; Options::requireAllFields turns an absent non-optional field into an error.
+/// Members with their own format, i.e. a deserialize() but no mapping, or a FromStringView() specialization, may still throw.
+/// </summary>
+enum class DeserializeError {
+    none,
+    malformedObject, // Missing braces
+    malformedField, // Key without " : "
+    malformedContainer, // Missing brackets or element count
+    elementCount, // Elements do not match the count, or the std::array size
+    invalidNumber, // Not a number, or out of range of the member
+    invalidCharacter, // A char member without exactly one character
+    invalidEscape, // Malformed escape sequence, or escaped text for a std::string_view outside an arena
+    missingField // Absent non-optional field, with Options::requireAllFields
+};
+
+constexpr std::string_view Describe(DeserializeError error) {
+    switch (error) {
+    case DeserializeError::none: return "no error";
+    case DeserializeError::malformedObject: return "object is not enclosed in braces";
+    case DeserializeError::malformedField: return "field without ' : ' between key and value";
+    case DeserializeError::malformedContainer: return "container is not enclosed in brackets or lacks an element count";
+    case DeserializeError::elementCount: return "container elements do not match their count";
+    case DeserializeError::invalidNumber: return "value is not a number in range";
+    case DeserializeError::invalidCharacter: return "value is not a single character";
+    case DeserializeError::invalidEscape: return "malformed escape sequence, or escaped text viewed outside an arena";
+    case DeserializeError::missingField: return "required field is absent";
+    }
+    return "unknown error";
+}
+
+// Either a decoded object or the reason decoding failed, in the manner of C++23 std::expected
+template <class T>
+class DeserializeResult {
+public:
+    constexpr DeserializeResult(T value) : value_{ std::move(value) } {}
+
+    constexpr DeserializeResult(DeserializeError error, std::size_t offset) : error_{ error }, offset_{ offset } {}
+
+    [[nodiscard]] constexpr bool has_value() const { return value_.has_value(); }
+    constexpr explicit operator bool() const { return has_value(); }
+
+    // Only valid when has_value()
+    [[nodiscard]] constexpr T& value() & { return *value_; }
+    [[nodiscard]] constexpr const T& value() const& { return *value_; }
+    [[nodiscard]] constexpr T&& value() && { return *std::move(value_); }
+    constexpr T& operator*() & { return *value_; }
+    constexpr const T& operator*() const& { return *value_; }
+    constexpr T* operator->() { return &*value_; }
+    constexpr const T* operator->() const { return &*value_; }
+
+    [[nodiscard]] constexpr DeserializeError error() const { return error_; }
+
+    // Byte offset in the input where the error was detected; 0 on success
+    [[nodiscard]] constexpr std::size_t offset() const { return offset_; }
+
+private:
+    std::optional<T> value_{ };
+    DeserializeError error_{ DeserializeError::none };
+    std::size_t offset_{ 0 };
+};
+
+namespace checked {
+
+struct Options {
+    bool requireAllFields{ false }; // Absent non-optional fields are errors rather than defaults
+};
+
+// First error met while decoding; positions are reported relative to the start of the whole input
+class Context {
+public:
+    constexpr Context(std::string_view input, Options options) : input_{ input }, options_{ options } {}
+
+    // Record an error found at the start of 'at', a view into the input; always returns false so callers can 'return context.fail(...)'
+    constexpr bool fail(DeserializeError error, std::string_view at) {
+        error_ = error;
+        offset_ = static_cast<std::size_t>(at.data() - input_.data());
+        return false;
+    }
+
+    [[nodiscard]] constexpr DeserializeError error() const { return error_; }
+    [[nodiscard]] constexpr std::size_t offset() const { return offset_; }
+    [[nodiscard]] constexpr const Options& options() const { return options_; }
+
+private:
+    std::string_view input_;
+    Options options_;
+    DeserializeError error_{ DeserializeError::none };
+    std::size_t offset_{ 0 };
+};
+
+template <class T> constexpr bool TryDecode(T& target, std::string_view value, Context& context);
+
+// SplitContainer() without the exceptions
+constexpr bool TrySplitContainer(std::string_view value, ContainerText& container, Context& context) {
+    if (value.size() < 3 || value.front() != '[' || value.back() != ']') { return context.fail(DeserializeError::malformedContainer, value); }
+    const auto inner = value.substr(1, value.size() - 2);
+    const auto countEnd = std::min(inner.find(' '), inner.size());
+    const auto count = number::FromChars<std::size_t>(inner.data(), inner.data() + countEnd);
+    if (!count.has_value()) { return context.fail(DeserializeError::malformedContainer, inner); }
+    auto elements = inner.substr(countEnd);
+    if (*count == 0 ? !elements.empty() : elements.substr(0, 3) != " : ") { return context.fail(DeserializeError::malformedContainer, elements); }
+    elements.remove_prefix(std::min(elements.size(), std::size_t{ 3 }));
+    container = ContainerText{ *count, elements };
+    return true;
+}
+
+// ForEachElement() without the exceptions; stops at the first element the visitor rejects
+template <class VISITOR> constexpr bool TryForEachElement(const ContainerText& container, Context& context, VISITOR&& visit) {
+    const auto elements = container.elements;
+    auto pos = std::size_t{ 0 };
+    for (auto index = std::size_t{ 0 }; index < container.count; ++index) {
+        if (pos > elements.size()) { return context.fail(DeserializeError::elementCount, elements.substr(elements.size())); }
+        const auto endPos = FindUnnested(elements, pos, ',');
+        if (!visit(index, TrimWhitespace(elements.substr(pos, endPos - pos)))) { return false; }
+        pos = endPos + 1;
+    }
+    if (container.count != 0 && pos != elements.size() + 1) { return context.fail(DeserializeError::elementCount, elements.substr(std::min(pos, elements.size()))); }
+    return true;
+}
+
+template <class T> constexpr bool TryDecodeContainer(T& target, std::string_view value, Context& context) {
+    using namespace serializable::traits;
+
+    auto container = ContainerText{ };
+    if (!TrySplitContainer(value, container, context)) { return false; }
+    if constexpr (isStdArray<T>) {
+        if (container.count != target.size()) { return context.fail(DeserializeError::elementCount, value); }
+        return TryForEachElement(container, context, [&target, &context](std::size_t index, std::string_view element) { return TryDecode(target[index], element, context); });
+    }
+    else if constexpr (isVector<T>) {
+        if (container.count > MaxElementCount(container.elements)) { return context.fail(DeserializeError::elementCount, value); }
+        target.resize(container.count);
+        return TryForEachElement(container, context, [&target, &context](std::size_t index, std::string_view element) { return TryDecode(target[index], element, context); });
+    }
+    else {
+        target.clear();
+        return TryForEachElement(container, context, [&target, &context](std::size_t, std::string_view element) {
+            if constexpr (isSet<T>) {
+                auto key = typename T::value_type{ };
+                if (!TryDecode(key, element, context)) { return false; }
+                target.emplace_hint(target.end(), std::move(key));
+            }
+            else {
+                const auto colonPos = FindUnnested(element, 0, ':');
+                if (colonPos >= element.size()) { return context.fail(DeserializeError::malformedContainer, element); }
+                auto key = typename T::key_type{ };
+                auto mapped = typename T::mapped_type{ };
+                if (!TryDecode(key, TrimWhitespace(element.substr(0, colonPos)), context) || !TryDecode(mapped, TrimWhitespace(element.substr(colonPos + 1)), context)) { return false; }
+                target.emplace_hint(target.end(), std::move(key), std::move(mapped));
+            }
+            return true;
+        });
+    }
+}
+
+// ForEachKeyValue() with every separator checked; stops at the first pair the visitor rejects
+template <class SCANNER, class VISITOR> constexpr bool TryForEachKeyValue(std::string_view body, SCANNER&& scanner, Context& context, VISITOR&& visit) {
+    auto keyBeginPos = std::size_t{ 0 };
+    while (keyBeginPos < body.size()) {
+        keyBeginPos = scanner.skipWhitespace(keyBeginPos);
+        if (keyBeginPos >= body.size()) { break; } // Only whitespace remains
+        const auto colonPos = scanner.findColon(keyBeginPos);
+        if (colonPos >= body.size() || colonPos == keyBeginPos || body[colonPos - 1] != ' ' || colonPos + 1 >= body.size() || body[colonPos + 1] != ' ') {
+            return context.fail(DeserializeError::malformedField, body.substr(keyBeginPos));
+        }
+        const auto valueBeginPos = colonPos + 2;
+        const auto endPos = scanner.findValueEnd(valueBeginPos);
+        auto value = body.substr(valueBeginPos, endPos - valueBeginPos);
+        while (!value.empty() && IsWhitespace(value.back())) { value.remove_suffix(1); } // Trim trailing whitespace
+        if (!visit(body.substr(keyBeginPos, colonPos - 1 - keyBeginPos), value)) { return false; }
+        keyBeginPos = endPos + 1;
+    }
+    return true;
+}
+
+template <class T> constexpr bool TryDecodeObject(T& target, std::string_view input, Context& context) {
+    using namespace serializable::traits;
+    constexpr auto list = T::DefineMemberMapping(); // Create this separately to elide runtime call
+    constexpr auto size = std::tuple_size_v<decltype(list)>;
+
+    if (input.size() < 2 || input.front() != '{' || input.back() != '}') { return context.fail(DeserializeError::malformedObject, input); }
+    const auto body = input.substr(1, input.size() - 2);
+
+    auto values = std::array<std::string_view, size>{ }; // Indexed the same as the mapping
+    auto seen = std::array<bool, size>{ };
+    auto Collect = [&values, &seen](std::string_view key, std::string_view value) {
+        const auto index = keyIndex<T>.find(key);
+        if (index == keyIndex<T>.npos) { instrumentation::CountUnknownKey<T>(); } // Includes a schema fingerprint header
+        else {
+            values[index] = value;
+            seen[index] = true;
+        }
+        return true;
+    };
+    const auto collected = limited_constexpr::IsConstantEvaluated() || body.size() < structural::blockSize
+        ? TryForEachKeyValue(body, ScalarScanner{ body }, context, Collect)
+        : TryForEachKeyValue(body, IndexedScanner{ body }, context, Collect); // SIMD structural scanning
+    if (!collected) { return false; }
+
+    auto counter = std::size_t{ 0 };
+    auto DecodeField = [&target, &values, &seen, &counter, &context, input](auto&& element) {
+        using MEMBER = std::decay_t<decltype(target.*(element.member_))>;
+        const auto index = counter++;
+        if (!seen[index]) {
+            if (context.options().requireAllFields && !isOptional<MEMBER>) { return context.fail(DeserializeError::missingField, input.substr(input.size() - 1)); }
+            return true; // Absent fields keep their default
+        }
+        return TryDecode(target.*(element.member_), values[index], context);
+    };
+    return std::apply([&DecodeField](auto &&...element) { return (DecodeField(element) && ...); }, list);
+}
+
+// Decode a single value in place; the counterpart of deserializeInternalInto() which reports failure instead of throwing
+template <class T> constexpr bool TryDecode(T& target, std::string_view value, Context& context) {
+    using namespace serializable::traits;
+
+    if constexpr (isOptional<T>) {
+        if (value.empty()) { // Null values are omitted
+            target.reset();
+            return true;
+        }
+        if (!target.has_value()) { target.emplace(); }
+        return TryDecode(*target, value, context);
+    }
+    else if constexpr (isContainer<T>) {
+        return TryDecodeContainer(target, value, context);
+    }
+    else if constexpr (std::is_enum_v<T>) {
+        auto underlying = std::underlying_type_t<T>{ };
+        if (!TryDecode(underlying, value, context)) { return false; }
+        target = static_cast<T>(underlying);
+        return true;
+    }
+    else if constexpr (hasSerializationInterface<T> && hasMemberMapping<T>) {
+        return TryDecodeObject(target, value, context);
+    }
+    else if constexpr (hasSerializationInterface<T>) {
+        target = T::deserialize(value); // Own format: may throw
+        return true;
+    }
+    else if constexpr (isString<T>) {
+        if (!escape::AssignUnescaped(target, value)) { return context.fail(DeserializeError::invalidEscape, value); }
+        return true;
+    }
+    else if constexpr (std::is_same_v<T, std::string_view>) {
+        if (!escape::IsEscaped(value)) {
+            target = FromStringView<std::string_view>(value);
+            return true;
+        }
+        if (limited_constexpr::IsConstantEvaluated()) { return context.fail(DeserializeError::invalidEscape, value); }
+        const auto unescaped = escape::RetainUnescaped(value);
+        if (!unescaped.has_value()) { return context.fail(DeserializeError::invalidEscape, value); }
+        target = *unescaped;
+        return true;
+    }
+    else if constexpr (std::is_same_v<T, char>) {
+        const auto c = escape::UnescapeChar(value);
+        if (!c.has_value()) { return context.fail(DeserializeError::invalidCharacter, value); }
+        target = *c;
+        return true;
+    }
+    else if constexpr (number::isNumber<T>) {
+        const auto number = number::FromChars<T>(value.data(), value.data() + value.size());
+        if (!number.has_value()) { return context.fail(DeserializeError::invalidNumber, value); }
+        target = *number;
+        return true;
+    }
+    else {
+        target = FromStringView<T>(value); // Own specialization: may throw
+        return true;
+    }
+}
+
+} // namespace checked
+
+// Deserialize untrusted input without exceptions: the object, or an error code and the byte offset where decoding stopped
+template <class T> constexpr DeserializeResult<T> tryDeserialize(std::string_view input, checked::Options options = { }) {
+    static_assert(serializable::traits::hasMemberMapping<T>, "Checked deserialization requires a member mapping");
+    auto context = checked::Context{ input, options };
+    auto result = T{ };
+    if (!checked::TryDecodeObject(result, input, context)) { return DeserializeResult<T>{ context.error(), context.offset() }; }
+    return DeserializeResult<T>{ std::move(result) };
+}
+
+#endif // !SERIAL_CHECKED_HPP
@@ -0,0 +1,436 @@
+#ifndef SERIAL_COLUMNAR_HPP
+#define SERIAL_COLUMNAR_HPP 1
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Serial_Binary_CRTP.hpp"
+#include "Serial_Fingerprint.hpp"
+#include "Serial_Number.hpp"
+#include "Serial_Type_Traits.hpp"
+#include "Serial_View.hpp"
+
+/// <summary>
+/// Columnar (structure-of-arrays) encoding of a batch of records driven by DefineMemberMapping(): each binding becomes one column
+/// holding that member for every record, contiguously, so a scan over one field reads only that field's bytes.
+/// A batch is the schema fingerprint (8 bytes) and the row count (8 bytes), then per binding the column's length (8 bytes) and the column, all little-endian.
+/// Columns are encoded by member type:
+///     integers & enums as zigzag varints of the difference to the previous row, so sorted or clustered values take a byte or two,
+///     bools as one bit per row,
+///     chars & strings as a dictionary of distinct values in order of first appearance, then each row's index into it bit-packed at the narrowest width
+///         (one bit at least, so that every row of nearly any type takes some input, and a corrupt row count cannot over-allocate),
+///     optionals as one presence bit per row followed by the column of the present values,
+///     nested mapped objects as the columns of their own members,
+///     floating point & containers in their binary encoding, one row after another.
+/// Decoded std::string_view members are views into the input.
+/// </summary>
+namespace columnar {
+
+using RowCount = std::uint64_t;
+using ColumnLength = std::uint64_t; // Columns of huge batches may pass 4 GB
+
+inline void RequireBytes(std::string_view input, std::size_t count) {
+    if (input.size() < count) { throw std::runtime_error{ "Error parsing columnar: truncated input." }; }
+}
+
+// Split 'count' bytes off the front of the input
+inline std::string_view Take(std::string_view& input, std::size_t count) {
+    RequireBytes(input, count);
+    const auto taken = input.substr(0, count);
+    input.remove_prefix(count);
+    return taken;
+}
+
+template <class UNSIGNED> void AppendFixed(std::string& output, UNSIGNED value) {
+    char bytes[sizeof(UNSIGNED)]{ };
+    binary::StoreLittleEndian(bytes, value);
+    output.append(bytes, sizeof(UNSIGNED));
+}
+
+template <class UNSIGNED> UNSIGNED ReadFixed(std::string_view& input) {
+    return binary::LoadLittleEndian<UNSIGNED>(Take(input, sizeof(UNSIGNED)).data());
+}
+
+// LEB128: seven bits per byte, least significant first, with the high bit set on every byte but the last
+inline void AppendVarint(std::string& output, std::uint64_t value) {
+    while (value >= 0x80) {
+        output.push_back(static_cast<char>(static_cast<unsigned char>(value | 0x80)));
+        value >>= 7;
+    }
+    output.push_back(static_cast<char>(static_cast<unsigned char>(value)));
+}
+
+inline std::uint64_t ReadVarint(std::string_view& input) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(input.data());
+    const auto limit = std::min(input.size(), std::size_t{ 10 }); // One bounds check per value rather than per byte
+    auto value = std::uint64_t{ 0 };
+    for (auto i = std::size_t{ 0 }; i < limit; ++i) {
+        value |= static_cast<std::uint64_t>(bytes[i] & 0x7F) << (7 * i);
+        if ((bytes[i] & 0x80) == 0) {
+            input.remove_prefix(i + 1);
+            return value;
+        }
+    }
+    throw std::runtime_error{ limit < 10 ? "Error parsing columnar: truncated input." : "Error parsing columnar: malformed varint." };
+}
+
+// Differences of either sign mapped so small magnitudes stay small: 0, -1, 1, -2... become 0, 1, 2, 3...
+constexpr std::uint64_t ZigZag(std::uint64_t delta) {
+    return (delta << 1) ^ (0 - (delta >> 63));
+}
+
+constexpr std::uint64_t UnZigZag(std::uint64_t encoded) {
+    return (encoded >> 1) ^ (0 - (encoded & 1));
+}
+
+// Integers & enums as 64 bits; signed values are sign-extended, so differences wrap consistently in both directions
+template <class T> constexpr std::uint64_t Widen(T value) {
+    if constexpr (std::is_enum_v<T>) { return Widen(static_cast<std::underlying_type_t<T>>(value)); }
+    else { return static_cast<std::uint64_t>(value); }
+}
+
+template <class T> constexpr T Narrow(std::uint64_t value) {
+    if constexpr (std::is_enum_v<T>) { return static_cast<T>(Narrow<std::underlying_type_t<T>>(value)); }
+    else { return static_cast<T>(value); }
+}
+
+// Bits needed to hold every value up to 'maximum'
+constexpr unsigned BitWidth(std::uint64_t maximum) {
+    auto width = 0u;
+    while (width < 64 && (maximum >> width) != 0) { ++width; }
+    return width;
+}
+
+// Width of the dictionary indices for 'entryCount' entries; never zero, even for a single entry
+constexpr unsigned CodeWidth(std::uint64_t entryCount) {
+    return std::max(1u, BitWidth(entryCount == 0 ? 0 : entryCount - 1));
+}
+
+// 'count' values of 'width' bits each (at most 32), least significant bit first, padded to a whole byte
+template <class GET> void AppendBitPacked(std::string& output, std::size_t count, unsigned width, GET&& get) {
+    auto buffer = std::uint64_t{ 0 };
+    auto bits = 0u;
+    for (auto i = std::size_t{ 0 }; i < count; ++i) {
+        buffer |= static_cast<std::uint64_t>(get(i)) << bits;
+        bits += width;
+        for (; bits >= 8; bits -= 8, buffer >>= 8) { output.push_back(static_cast<char>(static_cast<unsigned char>(buffer))); }
+    }
+    if (bits > 0) { output.push_back(static_cast<char>(static_cast<unsigned char>(buffer))); }
+}
+
+// Bytes of 'count' bit-packed values, split off the front of the input
+inline std::string_view TakeBitPacked(std::string_view& input, std::size_t count, unsigned width) {
+    if (width != 0 && count > (std::numeric_limits<std::size_t>::max() - 7) / width) { throw std::runtime_error{ "Error parsing columnar: row count out of range." }; }
+    return Take(input, (count * width + 7) / 8);
+}
+
+class BitUnpacker {
+public:
+    BitUnpacker(std::string_view bytes, unsigned width) : bytes_{ bytes }, width_{ width } {}
+
+    // Callers read no more values than were packed into the bytes
+    std::uint32_t next() {
+        for (; bits_ < width_; bits_ += 8) { buffer_ |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes_[position_++])) << bits_; }
+        const auto value = static_cast<std::uint32_t>(buffer_ & ((std::uint64_t{ 1 } << width_) - 1));
+        buffer_ >>= width_;
+        bits_ -= width_;
+        return value;
+    }
+
+private:
+    std::string_view bytes_;
+    unsigned width_;
+    std::size_t position_{ 0 };
+    std::uint64_t buffer_{ 0 };
+    unsigned bits_{ 0 };
+};
+
+template <class T> std::string_view TextOf(const T& value) {
+    if constexpr (std::is_same_v<T, char>) { return { &value, 1 }; }
+    else { return { value.data(), value.size() }; }
+}
+
+template <class T> T FromText(std::string_view text) {
+    if constexpr (std::is_same_v<T, char>) { return text.front(); }
+    else { return T(text.data(), text.size()); }
+}
+
+///////////////////////
+
+template <class M> void EncodeColumn(std::string& output, const std::vector<const M*>& values);
+
+// One column per binding, each preceded by its length so readers can skip to any column
+template <class T> void EncodeColumns(std::string& output, const std::vector<const T*>& rows) {
+    auto EncodeBinding = [&output, &rows](auto&& element) {
+        using MEMBER = std::decay_t<decltype(std::declval<T>().*(element.member_))>;
+        auto values = std::vector<const MEMBER*>{ };
+        values.reserve(rows.size());
+        for (const auto* row : rows) { values.push_back(&(row->*(element.member_))); }
+
+        const auto lengthPos = output.size();
+        output.resize(lengthPos + sizeof(ColumnLength));
+        EncodeColumn(output, values);
+        binary::StoreLittleEndian(&output[lengthPos], static_cast<ColumnLength>(output.size() - lengthPos - sizeof(ColumnLength)));
+    };
+    std::apply([&EncodeBinding](auto &&...element) { (EncodeBinding(element), ...); }, T::DefineMemberMapping());
+}
+
+// Distinct values in order of first appearance, each as a varint length & its bytes, then every row's index into them
+template <class M> void EncodeDictionary(std::string& output, const std::vector<const M*>& values) {
+    auto entries = std::vector<std::string_view>{ };
+    auto codes = std::vector<std::uint32_t>(values.size());
+    if constexpr (std::is_same_v<M, char>) {
+        auto codeOf = std::array<std::int32_t, 256>{ };
+        codeOf.fill(-1);
+        for (auto i = std::size_t{ 0 }; i < values.size(); ++i) {
+            auto& code = codeOf[static_cast<unsigned char>(*values[i])];
+            if (code < 0) {
+                code = static_cast<std::int32_t>(entries.size());
+                entries.push_back(TextOf(*values[i]));
+            }
+            codes[i] = static_cast<std::uint32_t>(code);
+        }
+    }
+    else {
+        auto codeOf = std::unordered_map<std::string_view, std::uint32_t>{ };
+        for (auto i = std::size_t{ 0 }; i < values.size(); ++i) {
+            const auto [location, inserted] = codeOf.try_emplace(TextOf(*values[i]), static_cast<std::uint32_t>(entries.size()));
+            if (inserted) { entries.push_back(location->first); }
+            codes[i] = location->second;
+        }
+    }
+
+    AppendVarint(output, entries.size());
+    for (const auto entry : entries) {
+        AppendVarint(output, entry.size());
+        output.append(entry);
+    }
+    const auto width = CodeWidth(entries.size());
+    AppendBitPacked(output, codes.size(), width, [&codes](std::size_t i) { return codes[i]; });
+}
+
+template <class M> void EncodeColumn(std::string& output, const std::vector<const M*>& values) {
+    using namespace serializable::traits;
+
+    if constexpr (isOptional<M>) {
+        AppendBitPacked(output, values.size(), 1, [&values](std::size_t i) { return values[i]->has_value() ? 1u : 0u; });
+        auto present = std::vector<const typename M::value_type*>{ };
+        for (const auto* value : values) {
+            if (value->has_value()) { present.push_back(&value->value()); }
+        }
+        EncodeColumn(output, present);
+    }
+    else if constexpr (hasMemberMapping<M>) {
+        EncodeColumns(output, values);
+    }
+    else if constexpr (std::is_same_v<M, bool>) {
+        AppendBitPacked(output, values.size(), 1, [&values](std::size_t i) { return *values[i] ? 1u : 0u; });
+    }
+    else if constexpr (number::isInteger<M> || std::is_enum_v<M>) {
+        auto previous = std::uint64_t{ 0 };
+        for (const auto* value : values) {
+            const auto current = Widen(*value);
+            AppendVarint(output, ZigZag(current - previous));
+            previous = current;
+        }
+    }
+    else if constexpr (escape::isText<M>) {
+        EncodeDictionary(output, values);
+    }
+    else if constexpr (binary::isScalar<M> || isContainer<M>) {
+        auto size = std::size_t{ 0 };
+        for (const auto* value : values) { size += binary::EncodedSize(*value); }
+        const auto offset = output.size();
+        output.resize(offset + size);
+        auto* cursor = &output[0] + offset;
+        for (const auto* value : values) { binary::Encode(cursor, *value); }
+    }
+    else {
+        static_assert(hasMemberMapping<M>, "Member type has no columnar encoding");
+    }
+}
+
+///////////////////////
+
+template <class M, class VISITOR> void DecodeColumn(std::string_view& input, std::size_t count, VISITOR&& visit);
+
+// Fill 'count' rows from the columns of their bindings
+template <class T> void DecodeColumns(std::string_view& input, T* rows, std::size_t count) {
+    auto DecodeBinding = [&input, rows, count](auto&& element) {
+        using MEMBER = std::decay_t<decltype(std::declval<T>().*(element.member_))>;
+        auto column = Take(input, ReadFixed<ColumnLength>(input));
+        DecodeColumn<MEMBER>(column, count, [rows, member = element.member_](std::size_t row, MEMBER&& value) { rows[row].*member = std::move(value); });
+        if (!column.empty()) { throw std::runtime_error{ "Error parsing columnar: column longer than its rows." }; }
+    };
+    std::apply([&DecodeBinding](auto &&...element) { (DecodeBinding(element), ...); }, T::DefineMemberMapping());
+}
+
+template <class M, class VISITOR> void DecodeDictionary(std::string_view& input, std::size_t count, VISITOR&& visit) {
+    const auto entryCount = ReadVarint(input);
+    if (entryCount > input.size() || (entryCount == 0 && count != 0)) { throw std::runtime_error{ "Error parsing columnar: malformed dictionary." }; } // Each entry takes a byte at least
+    auto entries = std::vector<std::string_view>{ };
+    entries.reserve(static_cast<std::size_t>(entryCount));
+    for (auto i = std::uint64_t{ 0 }; i < entryCount; ++i) {
+        entries.push_back(Take(input, static_cast<std::size_t>(ReadVarint(input))));
+        if constexpr (std::is_same_v<M, char>) {
+            if (entries.back().size() != 1) { throw std::runtime_error{ "Error parsing columnar: malformed dictionary." }; }
+        }
+    }
+
+    const auto width = CodeWidth(entryCount);
+    auto codes = BitUnpacker{ TakeBitPacked(input, count, width), width };
+    for (auto row = std::size_t{ 0 }; row < count; ++row) {
+        const auto code = codes.next();
+        if (code >= entries.size()) { throw std::runtime_error{ "Error parsing columnar: dictionary index out of range." }; }
+        visit(row, FromText<M>(entries[code]));
+    }
+}
+
+// Decode 'count' values from the front of the input, handing each to visit(row, M&&) in row order
+template <class M, class VISITOR> void DecodeColumn(std::string_view& input, std::size_t count, VISITOR&& visit) {
+    using namespace serializable::traits;
+
+    if constexpr (isOptional<M>) {
+        using VALUE = typename M::value_type;
+        const auto presenceBits = TakeBitPacked(input, count, 1);
+        auto presentCount = std::size_t{ 0 };
+        auto counter = BitUnpacker{ presenceBits, 1 };
+        for (auto row = std::size_t{ 0 }; row < count; ++row) { presentCount += counter.next(); }
+
+        // Present values arrive in row order; the null rows before each are visited first
+        auto presence = BitUnpacker{ presenceBits, 1 };
+        auto row = std::size_t{ 0 };
+        DecodeColumn<VALUE>(input, presentCount, [&visit, &presence, &row](std::size_t, VALUE&& value) {
+            while (presence.next() == 0) { visit(row++, M{ }); }
+            visit(row++, M{ std::move(value) });
+        });
+        while (row < count) { visit(row++, M{ }); }
+    }
+    else if constexpr (hasMemberMapping<M>) {
+        auto rows = std::vector<M>(count);
+        DecodeColumns(input, rows.data(), count);
+        for (auto row = std::size_t{ 0 }; row < count; ++row) { visit(row, std::move(rows[row])); }
+    }
+    else if constexpr (std::is_same_v<M, bool>) {
+        auto bits = BitUnpacker{ TakeBitPacked(input, count, 1), 1 };
+        for (auto row = std::size_t{ 0 }; row < count; ++row) { visit(row, bits.next() != 0); }
+    }
+    else if constexpr (number::isInteger<M> || std::is_enum_v<M>) {
+        auto previous = std::uint64_t{ 0 };
+        for (auto row = std::size_t{ 0 }; row < count; ++row) {
+            previous += UnZigZag(ReadVarint(input));
+            visit(row, Narrow<M>(previous));
+        }
+    }
+    else if constexpr (escape::isText<M>) {
+        DecodeDictionary<M>(input, count, visit);
+    }
+    else {
+        for (auto row = std::size_t{ 0 }; row < count; ++row) {
+            auto value = M{ };
+            binary::Decode(input, value);
+            visit(row, std::move(value));
+        }
+    }
+}
+
+template <class T> constexpr std::size_t MinRowBits();
+
+// Fewest bits a column of M takes per row, following the encodings of DecodeColumn()
+template <class M> constexpr std::size_t MinColumnBits() {
+    using namespace serializable::traits;
+
+    if constexpr (isOptional<M> || std::is_same_v<M, bool>) { return 1; }
+    else if constexpr (hasMemberMapping<M>) { return MinRowBits<M>(); }
+    else if constexpr (number::isInteger<M> || std::is_enum_v<M>) { return 8; }
+    else if constexpr (escape::isText<M>) { return 1; }
+    else if constexpr (binary::isScalar<M>) { return 8 * sizeof(M); }
+    else if constexpr (isStdArray<M>) { return 0; } // Possibly empty
+    else { return 8 * sizeof(binary::LengthPrefix); }
+}
+
+// Fewest bits a row of T takes over all its columns, so the input bounds the row count a batch can claim
+template <class T> constexpr std::size_t MinRowBits() {
+    return std::apply([](auto &&...element) {
+        return (std::size_t{ 0 } + ... + MinColumnBits<std::decay_t<decltype(std::declval<T>().*(element.member_))>>());
+    }, T::DefineMemberMapping());
+}
+
+// Check the schema fingerprint and read the row count. A count the remaining input cannot hold is rejected before any row is allocated.
+template <class T> std::size_t ReadHeader(std::string_view& input) {
+    if (ReadFixed<std::uint64_t>(input) != schemaFingerprint<T>) { throw std::runtime_error{ "Error parsing columnar: schema fingerprint mismatch." }; }
+    const auto count = ReadFixed<RowCount>(input);
+    if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) { throw std::runtime_error{ "Error parsing columnar: row count out of range." }; }
+    if constexpr (constexpr auto minRowBits = MinRowBits<T>(); minRowBits > 0) {
+        if (count > input.size() * 8 / minRowBits) { throw std::runtime_error{ "Error parsing columnar: row count exceeds input." }; }
+    }
+    return static_cast<std::size_t>(count);
+}
+
+template <class M, class C> C ClassOfMember(M C::*);
+
+// Type holding the member a pointer to member refers to
+template <auto MEMBER>
+using ClassOf = decltype(ClassOfMember(MEMBER));
+
+} // namespace columnar
+
+///////////////////////
+
+// Encode records as one column per binding
+template <class T> std::string serializeColumnar(const T* records, std::size_t count) {
+    auto output = std::string{ };
+    columnar::AppendFixed(output, schemaFingerprint<T>);
+    columnar::AppendFixed(output, static_cast<columnar::RowCount>(count));
+    auto rows = std::vector<const T*>(count);
+    for (auto i = std::size_t{ 0 }; i < count; ++i) { rows[i] = records + i; }
+    columnar::EncodeColumns(output, rows);
+    return output;
+}
+
+template <class T> std::string serializeColumnar(const std::vector<T>& records) {
+    return serializeColumnar(records.data(), records.size());
+}
+
+// Decode a columnar batch back into rows, appending them to 'output'. Views held by the deserialized objects (e.g. std::string_view members)
+// point into 'input'. Returns the number of records appended.
+template <class T> std::size_t deserializeColumnar(std::string_view input, std::vector<T>& output) {
+    static_assert(std::is_default_constructible_v<T>);
+    const auto count = columnar::ReadHeader<T>(input);
+    const auto first = output.size();
+    output.resize(first + count);
+    try {
+        columnar::DecodeColumns(input, output.data() + first, count);
+        if (!input.empty()) { throw std::runtime_error{ "Error parsing columnar: trailing bytes." }; }
+    }
+    catch (...) {
+        output.resize(first); // Leave the destination as it was
+        throw;
+    }
+    return count;
+}
+
+// Hand each record's value of one member to visit(const M&), in row order, decoding that column alone; other columns are skipped by their length
+template <auto MEMBER, class VISITOR> void scanColumn(std::string_view input, VISITOR&& visit) {
+    using T = columnar::ClassOf<MEMBER>;
+    using M = view_detail::MemberType<MEMBER>;
+    constexpr auto index = view_detail::BindingIndex<T, MEMBER>();
+    static_assert(index < std::tuple_size_v<decltype(T::DefineMemberMapping())>, "Member is not part of the mapping");
+
+    const auto count = columnar::ReadHeader<T>(input);
+    for (auto skipped = std::size_t{ 0 }; skipped < index; ++skipped) { columnar::Take(input, columnar::ReadFixed<columnar::ColumnLength>(input)); }
+    auto column = columnar::Take(input, columnar::ReadFixed<columnar::ColumnLength>(input));
+    columnar::DecodeColumn<M>(column, count, [&visit](std::size_t, M&& value) { visit(std::as_const(value)); });
+}
+
+#endif // !SERIAL_COLUMNAR_HPP
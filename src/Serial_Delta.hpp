@@ -0,0 +1,150 @@
+#ifndef SERIAL_DELTA_HPP
+#define SERIAL_DELTA_HPP 1
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include "Serial_CRTP.hpp"
+
+/// <summary>
+/// Field-level deltas between two objects of a mapped type, using the same text format and binding names as serialize().
+/// A delta lists only the fields whose value changed: nested mapped objects (plain or optional) carry a nested delta,
+/// any other field carries its full new value. A field that became null (empty optional or string) is written with an empty value,
+/// which tells it apart from an unchanged field, whose key is absent. Unchanged objects yield "{\n}".
+/// </summary>
+namespace delta {
+
+// Members diffed field by field instead of compared & rewritten whole
+template <class T>
+inline constexpr bool isNested = serializable::traits::hasSerializationInterface<T> && serializable::traits::hasMemberMapping<T>;
+
+template <class T> inline constexpr bool isOptionalNested = false;
+template <class T> inline constexpr bool isOptionalNested<std::optional<T>> = isNested<T>;
+
+template <class OUTPUT, class T> constexpr bool AppendChangedFields(OUTPUT& output, const T& old, const T& now, bool anyWritten);
+
+// Nested mapped objects are diffed rather than rewritten; no key is written when nothing inside changed
+template <class OUTPUT, class T> constexpr bool AppendNestedDelta(OUTPUT& output, std::size_t lineBegin, const T& old, const T& now) {
+    output.append("{\n");
+    if (!AppendChangedFields(output, old, now, false)) {
+        output.resize(lineBegin); // Roll back key
+        return false;
+    }
+    output.append("\n}");
+    return true;
+}
+
+// Append "key : value" for one field if it changed; returns whether anything was written
+template <class OUTPUT, class T, class BINDING> constexpr bool AppendChangedField(OUTPUT& output, const T& old, const T& now, const BINDING& binding, bool anyWritten) {
+    using MEMBER = std::decay_t<decltype(old.*(binding.member_))>;
+    const auto& before = old.*(binding.member_);
+    const auto& after = now.*(binding.member_);
+
+    if constexpr (!isNested<MEMBER>) {
+        if (before == after) { return false; }
+    }
+
+    const auto lineBegin = output.size();
+    if (anyWritten) { output.append(",\n"); }
+    output.push_back('\t');
+    output.append(binding.name_);
+    output.append(" : ");
+
+    if constexpr (isNested<MEMBER>) {
+        return AppendNestedDelta(output, lineBegin, before, after);
+    }
+    else if constexpr (isOptionalNested<MEMBER>) {
+        if (before.has_value() && after.has_value()) { return AppendNestedDelta(output, lineBegin, *before, *after); }
+        if (after.has_value()) {
+            // Newly present: a delta against a default-constructed object, applied onto one; "{\n}" when all defaults
+            output.append("{\n");
+            const auto any = AppendChangedFields(output, typename MEMBER::value_type{ }, *after, false);
+            output.append(any ? "\n}" : "}");
+        }
+        return true; // Newly absent: the empty value resets the optional
+    }
+    else {
+        serializeInternal(output, after); // Empty when the new value is null
+        return true;
+    }
+}
+
+template <class OUTPUT, class T> constexpr bool AppendChangedFields(OUTPUT& output, const T& old, const T& now, bool anyWritten) {
+    constexpr auto metadata = T::DefineMemberMapping(); // Create this separately to elide runtime call
+    auto AppendEach = [&output, &old, &now, &anyWritten](auto &&...binding) {
+        ((anyWritten = AppendChangedField(output, old, now, binding, anyWritten) || anyWritten), ...);
+    };
+    std::apply(AppendEach, metadata);
+    return anyWritten;
+}
+
+template <class T> constexpr void ApplyFields(T& object, std::string_view body);
+
+template <class M> constexpr void ApplyField(M& member, std::string_view value) {
+    if constexpr (isNested<M>) {
+        if (value.size() < 2 || value.front() != '{' || value.back() != '}') { throw std::runtime_error{ "Error parsing delta: expected a nested object." }; }
+        ApplyFields(member, value.substr(1, value.size() - 2));
+    }
+    else if constexpr (isOptionalNested<M>) {
+        if (value.empty()) {
+            member.reset();
+            return;
+        }
+        if (!member.has_value()) { member.emplace(); } // Newly present values are diffed against a default-constructed object
+        ApplyField(*member, value);
+    }
+    else {
+        member = deserializeInternal<M>(value);
+    }
+}
+
+// Apply the fields of a delta body (braces removed); members whose key is absent are left untouched
+template <class T> constexpr void ApplyFields(T& object, std::string_view body) {
+    constexpr auto metadata = T::DefineMemberMapping(); // Create this separately to elide runtime call
+    constexpr auto size = std::tuple_size_v<decltype(metadata)>;
+    auto values = std::array<std::string_view, size>{ }; // Indexed the same as the mapping
+    auto present = std::array<bool, size>{ };
+    ForEachMappedValue<T>(body, [&values, &present](std::size_t index, std::string_view value) {
+        values[index] = value;
+        present[index] = true;
+    });
+
+    auto counter = std::size_t{ 0 };
+    auto ApplyEach = [&object, &values, &present, &counter](auto &&...binding) {
+        ((present[counter] ? ApplyField(object.*(binding.member_), values[counter]) : void(), ++counter), ...);
+    };
+    std::apply(ApplyEach, metadata);
+}
+
+} // namespace delta
+
+///////////////////////
+
+// Append the delta turning 'old' into 'now'
+template <class OUTPUT, class T> constexpr void diffInto(OUTPUT& output, const T& old, const T& now) {
+    static_assert(serializable::traits::hasMemberMapping<T>, "diff requires a member mapping");
+    output.append("{\n");
+    if (delta::AppendChangedFields(output, old, now, false)) { output.push_back('\n'); }
+    output.push_back('}');
+}
+
+template <class T> std::string diff(const T& old, const T& now) {
+    auto output = std::string{ };
+    diffInto(output, old, now);
+    return output;
+}
+
+// Update 'object' in place from a delta produced by diff(); views held afterwards (e.g. std::string_view members) point into 'patch'
+template <class T> constexpr void applyPatch(T& object, std::string_view patch) {
+    static_assert(serializable::traits::hasMemberMapping<T>, "applyPatch requires a member mapping");
+    patch = TrimWhitespace(patch);
+    if (patch.size() < 2 || patch.front() != '{' || patch.back() != '}') { throw std::runtime_error{ "Error parsing delta: expected an object." }; }
+    delta::ApplyFields(object, patch.substr(1, patch.size() - 2));
+}
+
+#endif // !SERIAL_DELTA_HPP
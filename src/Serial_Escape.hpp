@@ -0,0 +1,234 @@
+#ifndef SERIAL_ESCAPE_HPP
+#define SERIAL_ESCAPE_HPP 1
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+#include "Serial_Arena.hpp"
+#include "Serial_Structural_Index.hpp"
+#include "Serial_Type_Traits.hpp"
+#include "Utilities_Limited_Constexpr.hpp"
+
+/// <summary>
+/// Escaping of text values (strings & chars), so values holding delimiters cannot break the record around them.
+/// Every structural character, '\n', '\t', '\r' and the backslash itself are written as a backslash and a code letter that is neither
+/// structural nor whitespace, so the scanners never see them; a space is escaped only at either end of a value, where element trimming would drop it.
+/// Finding the next character to escape is vectorized (AVX2 or SSE2, chosen once at runtime) and clean runs are copied in bulk,
+/// so values without any such character are appended in a single copy. On input, text without a backslash is used as is:
+/// std::string_view members keep viewing the input. Escaped text is unescaped into strings, or into the installed arena for views.
+/// </summary>
+namespace escape {
+
+inline constexpr char marker = '\\';
+
+// Text values: escaped on output and unescaped on input
+template <class T>
+inline constexpr bool isText = serializable::traits::isString<T> || std::is_same_v<T, std::string_view> || std::is_same_v<T, char>;
+
+constexpr bool NeedsEscape(char c) {
+    return structural::IsStructural(c) || structural::IsWhitespaceChar(c) || c == '\r' || c == marker;
+}
+
+// Letter following the marker for a character which needs escaping; spaces get one too, for the ends of values
+constexpr char CodeOf(char c) {
+    switch (c) {
+    case '{': return '(';
+    case '}': return ')';
+    case '[': return '<';
+    case ']': return '>';
+    case ':': return '=';
+    case ',': return ';';
+    case '\n': return 'n';
+    case '\t': return 't';
+    case '\r': return 'r';
+    case ' ': return '_';
+    default: return marker; // The marker itself
+    }
+}
+
+// Character an escape code stands for; '\0' for an unknown code
+constexpr char CharOf(char code) {
+    switch (code) {
+    case '(': return '{';
+    case ')': return '}';
+    case '<': return '[';
+    case '>': return ']';
+    case '=': return ':';
+    case ';': return ',';
+    case 'n': return '\n';
+    case 't': return '\t';
+    case 'r': return '\r';
+    case '_': return ' ';
+    case marker: return marker;
+    default: return '\0';
+    }
+}
+
+constexpr std::size_t FindSpecialScalar(std::string_view text, std::size_t pos) {
+    while (pos < text.size() && !NeedsEscape(text[pos])) { ++pos; }
+    return pos;
+}
+
+#ifdef SERIAL_STRUCTURAL_X86
+inline std::size_t FindSpecialSse2(std::string_view text, std::size_t pos) {
+    for (; pos + 16 <= text.size(); pos += 16) {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + pos));
+        const auto brackets = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('{')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('}'))),
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('[')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(']'))));
+        const auto separators = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(':')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(','))),
+            _mm_cmpeq_epi8(bytes, _mm_set1_epi8(marker)));
+        const auto whitespace = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t'))),
+            _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\r')));
+        const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(brackets, separators), whitespace)));
+        if (mask != 0) { return pos + static_cast<std::size_t>(structural::CountTrailingZeros(mask)); }
+    }
+    return FindSpecialScalar(text, pos);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+inline std::size_t FindSpecialAvx2(std::string_view text, std::size_t pos) {
+    for (; pos + 32 <= text.size(); pos += 32) {
+        const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(text.data() + pos));
+        const auto brackets = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('}'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('[')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(']'))));
+        const auto separators = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(','))),
+            _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(marker)));
+        const auto whitespace = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t'))),
+            _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\r')));
+        const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_or_si256(_mm256_or_si256(brackets, separators), whitespace)));
+        if (mask != 0) { return pos + static_cast<std::size_t>(structural::CountTrailingZeros(mask)); }
+    }
+    return FindSpecialSse2(text, pos); // At most one 16-byte step, then the scalar tail
+}
+#endif // SERIAL_STRUCTURAL_X86
+
+using FindSpecialFunction = std::size_t(*)(std::string_view, std::size_t);
+
+inline FindSpecialFunction SelectFindSpecial() {
+#ifdef SERIAL_STRUCTURAL_X86
+    return structural::CpuSupportsAvx2() ? FindSpecialAvx2 : FindSpecialSse2;
+#else
+    return [](std::string_view text, std::size_t pos) { return FindSpecialScalar(text, pos); };
+#endif
+}
+
+// Chosen once per process, on first use, like structural::ScanBlock()
+inline std::size_t FindSpecialSelected(std::string_view text, std::size_t pos) {
+    static const auto selected = SelectFindSpecial();
+    return selected(text, pos);
+}
+
+// Position of the first character at or after 'pos' which needs escaping; the text size if none
+constexpr std::size_t FindSpecial(std::string_view text, std::size_t pos) {
+    if (limited_constexpr::IsConstantEvaluated()) { return FindSpecialScalar(text, pos); }
+    return FindSpecialSelected(text, pos);
+}
+
+// Append the escaped form of a text value. Runs without special characters are appended whole.
+template <class OUTPUT> constexpr void AppendEscaped(OUTPUT& output, std::string_view text) {
+    auto runBegin = std::size_t{ 0 };
+    if (!text.empty() && text.front() == ' ') {
+        output.append("\\_");
+        runBegin = 1;
+    }
+    const auto trailingSpace = text.size() > runBegin && text.back() == ' ';
+    const auto inner = text.substr(0, text.size() - (trailingSpace ? 1 : 0));
+    for (;;) {
+        const auto pos = FindSpecial(inner, runBegin);
+        output.append(inner.substr(runBegin, pos - runBegin));
+        if (pos == inner.size()) { break; }
+        output.push_back(marker);
+        output.push_back(CodeOf(inner[pos]));
+        runBegin = pos + 1;
+    }
+    if (trailingSpace) { output.append("\\_"); }
+}
+
+// Exact length of AppendEscaped() output
+constexpr std::size_t EscapedSize(std::string_view text) {
+    auto size = text.size();
+    auto runBegin = std::size_t{ 0 };
+    if (!text.empty() && text.front() == ' ') {
+        ++size;
+        runBegin = 1;
+    }
+    const auto trailingSpace = text.size() > runBegin && text.back() == ' ';
+    const auto inner = text.substr(0, text.size() - (trailingSpace ? 1 : 0));
+    for (auto pos = FindSpecial(inner, runBegin); pos < inner.size(); pos = FindSpecial(inner, pos + 1)) { ++size; }
+    return trailingSpace ? size + 1 : size;
+}
+
+// Whether a serialized value holds escape sequences, i.e. cannot be used as is
+constexpr bool IsEscaped(std::string_view text) {
+    return text.find(marker) != std::string_view::npos; // memchr at runtime
+}
+
+inline constexpr std::size_t malformed = std::string_view::npos;
+
+// Write the unescaped form of 'text' to 'output', which has room for text.size() characters.
+// Returns the unescaped length, or 'malformed' for a trailing marker or an unknown code.
+constexpr std::size_t UnescapeTo(std::string_view text, char* output) {
+    auto size = std::size_t{ 0 };
+    auto runBegin = std::size_t{ 0 };
+    for (;;) {
+        const auto pos = std::min(text.find(marker, runBegin), text.size());
+        const auto run = text.substr(runBegin, pos - runBegin);
+        if (limited_constexpr::IsConstantEvaluated()) {
+            for (auto c : run) { output[size++] = c; }
+        }
+        else if (!run.empty()) {
+            std::memcpy(output + size, run.data(), run.size()); // Clean runs are copied whole
+            size += run.size();
+        }
+        if (pos == text.size()) { return size; }
+        if (pos + 1 == text.size() || CharOf(text[pos + 1]) == '\0') { return malformed; }
+        output[size++] = CharOf(text[pos + 1]);
+        runBegin = pos + 2;
+    }
+}
+
+// Character held by a serialized char value: one plain character or one escape sequence
+constexpr std::optional<char> UnescapeChar(std::string_view text) {
+    if (text.size() == 1 && text.front() != marker) { return text.front(); }
+    if (text.size() == 2 && text.front() == marker && CharOf(text.back()) != '\0') { return CharOf(text.back()); }
+    return std::nullopt;
+}
+
+// Assign the unescaped form of 'text' to a std::string or std::pmr::string, keeping its capacity; false for a malformed sequence
+template <class STRING> bool AssignUnescaped(STRING& target, std::string_view text) {
+    if (!IsEscaped(text)) {
+        target.assign(text.data(), text.size());
+        return true;
+    }
+    target.resize(text.size()); // Unescaping only ever shrinks
+    const auto size = UnescapeTo(text, target.data());
+    if (size == malformed) { return false; }
+    target.resize(size);
+    return true;
+}
+
+// Unescaped copy of escaped text owned by the installed arena; std::nullopt without an arena or for a malformed sequence
+inline std::optional<std::string_view> RetainUnescaped(std::string_view text) {
+    auto* resource = arena::CurrentResource();
+    if (resource == nullptr) { return std::nullopt; }
+    auto* copy = static_cast<char*>(resource->allocate(text.size(), alignof(char)));
+    const auto size = UnescapeTo(text, copy);
+    if (size == malformed) { return std::nullopt; }
+    return std::string_view{ copy, size };
+}
+
+} // namespace escape
+
+#endif // !SERIAL_ESCAPE_HPP
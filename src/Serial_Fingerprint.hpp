@@ -0,0 +1,88 @@
+#ifndef SERIAL_FINGERPRINT_HPP
+#define SERIAL_FINGERPRINT_HPP 1
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include "Serial_Hash.hpp"
+#include "Serial_Type_Traits.hpp"
+
+/// <summary>
+/// Compile-time schema fingerprint: a 64-bit FNV-1a hash of a type's bindings, covering each binding's name, its position
+/// and the type of its member, with nested mapped types (also inside optionals & containers) folded in through their own fingerprints.
+/// Two binaries agree on a fingerprint only when they would write the same fields in the same order,
+/// which lets a reader decode fingerprinted text by position instead of by key.
+/// Member types are identified by the compiler's spelling of them, so binaries from different compilers may disagree; they then use keys.
+/// </summary>
+namespace fingerprint {
+
+using fnv::offsetBasis;
+
+// Fold text into the hash, followed by a terminator so adjacent strings cannot run together
+constexpr std::uint64_t Mix(std::uint64_t hash, std::string_view text) {
+    return (fnv::Fold(hash, text) ^ 0xFF) * fnv::prime;
+}
+
+constexpr std::uint64_t Mix(std::uint64_t hash, std::uint64_t value) {
+    return fnv::Fold(hash, value);
+}
+
+template <class T> constexpr std::uint64_t SchemaFingerprint();
+
+// Member type, plus the schema of any mapped type it holds
+template <class M> constexpr std::uint64_t MemberFingerprint() {
+    using namespace serializable::traits;
+    const auto hash = Mix(offsetBasis, TypeName<M>());
+    if constexpr (hasMemberMapping<M>) { return Mix(hash, SchemaFingerprint<M>()); }
+    else if constexpr (isOptional<M>) { return Mix(hash, MemberFingerprint<typename M::value_type>()); }
+    else if constexpr (isMap<M>) { return Mix(Mix(hash, MemberFingerprint<typename M::key_type>()), MemberFingerprint<typename M::mapped_type>()); }
+    else if constexpr (isContainer<M>) { return Mix(hash, MemberFingerprint<typename M::value_type>()); }
+    else { return hash; }
+}
+
+template <class M, class C> constexpr std::uint64_t BindingFingerprint(std::uint64_t hash, M C::*, std::string_view name) {
+    return Mix(Mix(hash, name), MemberFingerprint<M>());
+}
+
+template <class T> constexpr std::uint64_t SchemaFingerprint() {
+    constexpr auto mapping = T::DefineMemberMapping();
+    auto hash = Mix(offsetBasis, std::tuple_size_v<decltype(mapping)>);
+    std::apply([&hash](const auto &...binding) { ((hash = BindingFingerprint(hash, binding.member_, binding.name_)), ...); }, mapping);
+    return hash;
+}
+
+// Lower-case hexadecimal digits of a fingerprint, most significant first
+constexpr std::array<char, 16> ToHex(std::uint64_t value) {
+    auto digits = std::array<char, 16>{ };
+    for (auto i = std::size_t{ 0 }; i < digits.size(); ++i) {
+        const auto nibble = static_cast<char>((value >> (4 * (digits.size() - 1 - i))) & 0xF);
+        digits[i] = nibble < 10 ? static_cast<char>('0' + nibble) : static_cast<char>('a' + nibble - 10);
+    }
+    return digits;
+}
+
+// Start of the body of a fingerprinted object: "\n\t@schema : <16 hex digits>". The header is an ordinary field whose key
+// no binding uses, so readers built from any other schema skip it as an unknown key.
+template <class T> constexpr auto MakeHeader() {
+    constexpr auto prefix = std::string_view{ "\n\t@schema : " };
+    constexpr auto hex = ToHex(SchemaFingerprint<T>());
+    auto header = std::array<char, prefix.size() + hex.size()>{ };
+    for (auto i = std::size_t{ 0 }; i < prefix.size(); ++i) { header[i] = prefix[i]; }
+    for (auto i = std::size_t{ 0 }; i < hex.size(); ++i) { header[prefix.size() + i] = hex[i]; }
+    return header;
+}
+
+template <class T>
+inline constexpr auto headerArray = MakeHeader<T>();
+
+template <class T>
+inline constexpr auto header = std::string_view{ headerArray<T>.data(), headerArray<T>.size() };
+
+} // namespace fingerprint
+
+template <class T>
+inline constexpr std::uint64_t schemaFingerprint = fingerprint::SchemaFingerprint<T>();
+
+#endif // !SERIAL_FINGERPRINT_HPP
@@ -0,0 +1,29 @@
+#ifndef SERIAL_HASH_HPP
+#define SERIAL_HASH_HPP 1
+
+#include <cstdint>
+#include <string_view>
+
+/// <summary>
+/// 64-bit FNV-1a, shared by the key index (hashing looked up keys) and the schema fingerprint (hashing bindings at compile time).
+/// Hashes start from offsetBasis and are extended a string or a fixed-width value at a time, so they can be built up incrementally.
+/// </summary>
+namespace fnv {
+
+inline constexpr std::uint64_t offsetBasis = 14695981039346656037ULL;
+inline constexpr std::uint64_t prime = 1099511628211ULL;
+
+constexpr std::uint64_t Fold(std::uint64_t hash, std::string_view text) {
+    for (auto c : text) { hash = (hash ^ static_cast<unsigned char>(c)) * prime; }
+    return hash;
+}
+
+// Little-endian bytes of a value, so the hash does not depend on host endianness
+constexpr std::uint64_t Fold(std::uint64_t hash, std::uint64_t value) {
+    for (auto i = 0; i < 8; ++i) { hash = (hash ^ ((value >> (8 * i)) & 0xFF)) * prime; }
+    return hash;
+}
+
+} // namespace fnv
+
+#endif // !SERIAL_HASH_HPP
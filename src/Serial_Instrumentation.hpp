@@ -0,0 +1,260 @@
+#ifndef SERIAL_INSTRUMENTATION_HPP
+#define SERIAL_INSTRUMENTATION_HPP 1
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Serial_Type_Traits.hpp"
+#include "Utilities_Limited_Constexpr.hpp"
+
+/// <summary>
+/// Per-type counters for the serialization engine, compiled in only when SERIAL_INSTRUMENTATION is defined.
+/// Without it every hook is discarded by 'if constexpr' and the engine is unchanged. With it, each mapped type counts
+/// top-level serialize / deserialize calls, bytes produced & consumed, parse failures and a latency histogram,
+/// along with null fields omitted from output and unrecognized keys skipped on input.
+/// Counters are atomics shared by all threads; Publish() hands a snapshot of every type seen so far to a Sink.
+/// Constant evaluation is never instrumented.
+/// </summary>
+namespace instrumentation {
+
+#ifdef SERIAL_INSTRUMENTATION
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+enum class Operation { serialize, deserialize };
+
+// Latency buckets by bit width of the duration in nanoseconds: bucket 0 holds 0 ns, bucket b holds [2^(b-1), 2^b) ns
+inline constexpr std::size_t histogramBuckets = 40;
+
+using Histogram = std::array<std::uint64_t, histogramBuckets>;
+
+constexpr std::size_t BucketOf(std::uint64_t nanoseconds) {
+    auto bucket = std::size_t{ 0 };
+    while (nanoseconds != 0 && bucket + 1 < histogramBuckets) {
+        nanoseconds >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+// Upper bound in nanoseconds of the bucket holding the given quantile (0...1) of the recorded latencies; 0 when nothing was recorded
+constexpr std::uint64_t Quantile(const Histogram& histogram, double quantile) {
+    auto total = std::uint64_t{ 0 };
+    for (auto count : histogram) { total += count; }
+    if (total == 0) { return 0; }
+
+    const auto rank = static_cast<std::uint64_t>(quantile * static_cast<double>(total - 1));
+    auto seen = std::uint64_t{ 0 };
+    for (auto bucket = std::size_t{ 0 }; bucket < histogramBuckets; ++bucket) {
+        seen += histogram[bucket];
+        if (seen > rank) { return (std::uint64_t{ 1 } << bucket) - 1; }
+    }
+    return (std::uint64_t{ 1 } << (histogramBuckets - 1)) - 1;
+}
+
+// Snapshot of one operation of one type
+struct OperationStatistics {
+    std::uint64_t calls{ 0 };
+    std::uint64_t bytes{ 0 }; // Produced by serialize, consumed by deserialize
+    std::uint64_t failures{ 0 }; // Calls which threw, e.g. malformed input
+    Histogram latency{ };
+};
+
+// Snapshot of one type, as handed to a Sink
+struct Statistics {
+    std::string_view type;
+    OperationStatistics serialize;
+    OperationStatistics deserialize;
+    std::uint64_t nullFieldsOmitted{ 0 };
+    std::uint64_t unknownKeysSkipped{ 0 };
+};
+
+class OperationCounters {
+public:
+    void record(std::size_t bytes, std::uint64_t nanoseconds) {
+        calls_.fetch_add(1, std::memory_order_relaxed);
+        bytes_.fetch_add(bytes, std::memory_order_relaxed);
+        latency_[BucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void recordFailure() {
+        calls_.fetch_add(1, std::memory_order_relaxed);
+        failures_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] OperationStatistics snapshot() const {
+        auto result = OperationStatistics{ calls_.load(std::memory_order_relaxed), bytes_.load(std::memory_order_relaxed), failures_.load(std::memory_order_relaxed) };
+        for (auto bucket = std::size_t{ 0 }; bucket < histogramBuckets; ++bucket) { result.latency[bucket] = latency_[bucket].load(std::memory_order_relaxed); }
+        return result;
+    }
+
+    void reset() {
+        calls_.store(0, std::memory_order_relaxed);
+        bytes_.store(0, std::memory_order_relaxed);
+        failures_.store(0, std::memory_order_relaxed);
+        for (auto& count : latency_) { count.store(0, std::memory_order_relaxed); }
+    }
+
+private:
+    std::atomic<std::uint64_t> calls_{ 0 };
+    std::atomic<std::uint64_t> bytes_{ 0 };
+    std::atomic<std::uint64_t> failures_{ 0 };
+    std::array<std::atomic<std::uint64_t>, histogramBuckets> latency_{ };
+};
+
+class Counters {
+public:
+    explicit Counters(std::string_view type) : type_{ type } { }
+
+    [[nodiscard]] OperationCounters& of(Operation operation) { return operation == Operation::serialize ? serialize_ : deserialize_; }
+
+    void countNullOmitted() { nullFieldsOmitted_.fetch_add(1, std::memory_order_relaxed); }
+    void countUnknownKey() { unknownKeysSkipped_.fetch_add(1, std::memory_order_relaxed); }
+
+    [[nodiscard]] Statistics snapshot() const {
+        return Statistics{ type_, serialize_.snapshot(), deserialize_.snapshot(),
+            nullFieldsOmitted_.load(std::memory_order_relaxed), unknownKeysSkipped_.load(std::memory_order_relaxed) };
+    }
+
+    void reset() {
+        serialize_.reset();
+        deserialize_.reset();
+        nullFieldsOmitted_.store(0, std::memory_order_relaxed);
+        unknownKeysSkipped_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::string_view type_;
+    OperationCounters serialize_;
+    OperationCounters deserialize_;
+    std::atomic<std::uint64_t> nullFieldsOmitted_{ 0 };
+    std::atomic<std::uint64_t> unknownKeysSkipped_{ 0 };
+};
+
+// Every type instrumented so far, in order of first use
+class Registry {
+public:
+    void add(Counters* counters) {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        counters_.push_back(counters);
+    }
+
+    template <class VISITOR> void forEach(VISITOR&& visit) {
+        std::lock_guard<std::mutex> lock{ mutex_ };
+        for (auto* counters : counters_) { visit(*counters); }
+    }
+
+private:
+    std::mutex mutex_;
+    std::vector<Counters*> counters_;
+};
+
+inline Registry& GlobalRegistry() {
+    static auto registry = Registry{ };
+    return registry;
+}
+
+// Counters of T, registered on first use
+template <class T> Counters& CountersOf() {
+    struct Registered {
+        Registered() { GlobalRegistry().add(&counters); }
+        Counters counters{ serializable::traits::TypeName<T>() };
+    };
+    static Registered registered;
+    return registered.counters;
+}
+
+// Receives the statistics of each instrumented type, e.g. to forward them to a metrics system
+class Sink {
+public:
+    virtual ~Sink() = default;
+    virtual void publish(const Statistics& statistics) = 0;
+};
+
+// One line per type and operation, e.g. for logs
+class StreamSink : public Sink {
+public:
+    explicit StreamSink(std::ostream& output) : output_{ output } { }
+
+    void publish(const Statistics& statistics) override {
+        write(statistics.type, "serialize", statistics.serialize);
+        write(statistics.type, "deserialize", statistics.deserialize);
+        output_ << statistics.type << " fields: null omitted " << statistics.nullFieldsOmitted << ", unknown keys skipped " << statistics.unknownKeysSkipped << '\n';
+    }
+
+private:
+    void write(std::string_view type, std::string_view operation, const OperationStatistics& statistics) {
+        output_ << type << ' ' << operation << ": calls " << statistics.calls << ", bytes " << statistics.bytes << ", failures " << statistics.failures
+            << ", p50 <= " << Quantile(statistics.latency, 0.5) << " ns, p99 <= " << Quantile(statistics.latency, 0.99) << " ns\n";
+    }
+
+    std::ostream& output_;
+};
+
+// Hand a snapshot of every type instrumented so far to the sink
+inline void Publish(Sink& sink) {
+    GlobalRegistry().forEach([&sink](const Counters& counters) { sink.publish(counters.snapshot()); });
+}
+
+template <class T> Statistics StatisticsOf() {
+    return CountersOf<T>().snapshot();
+}
+
+// Zero all counters, e.g. after each reporting interval
+inline void Reset() {
+    GlobalRegistry().forEach([](Counters& counters) { counters.reset(); });
+}
+
+///////////////////////
+
+// Hooks called by the engine; each one vanishes unless instrumentation is enabled
+
+template <class T> constexpr void CountNullOmitted() {
+    if constexpr (enabled) {
+        if (!limited_constexpr::IsConstantEvaluated()) { CountersOf<T>().countNullOmitted(); }
+    }
+}
+
+template <class T> constexpr void CountUnknownKey() {
+    if constexpr (enabled) {
+        if (!limited_constexpr::IsConstantEvaluated()) { CountersOf<T>().countUnknownKey(); }
+    }
+}
+
+// Time one top-level call on behalf of T. 'bytesOf' maps the result of 'function' to the bytes produced or consumed;
+// an exception counts as a failure and propagates.
+template <class T, class FUNCTION, class BYTES> auto Measure(Operation operation, FUNCTION&& function, BYTES&& bytesOf) {
+    auto& counters = CountersOf<T>().of(operation);
+    const auto start = std::chrono::steady_clock::now();
+    try {
+        auto result = function();
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+        counters.record(bytesOf(std::as_const(result)), static_cast<std::uint64_t>(elapsed.count()));
+        return result;
+    }
+    catch (...) {
+        counters.recordFailure();
+        throw;
+    }
+}
+
+// Run 'function' through Measure() when instrumentation is enabled; just run it otherwise, or in constant evaluation
+template <class T, class FUNCTION, class BYTES> constexpr auto Instrumented(Operation operation, FUNCTION&& function, [[maybe_unused]] BYTES&& bytesOf) {
+    if constexpr (enabled) {
+        if (!limited_constexpr::IsConstantEvaluated()) { return Measure<T>(operation, function, bytesOf); }
+    }
+    return function();
+}
+
+} // namespace instrumentation
+
+#endif // !SERIAL_INSTRUMENTATION_HPP
@@ -0,0 +1,140 @@
+#ifndef SERIAL_KEY_INDEX_HPP
+#define SERIAL_KEY_INDEX_HPP 1
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include "Serial_Hash.hpp"
+
+/// <summary>
+/// Compile-time perfect hash from binding names to binding indices.
+/// Keys are spread over buckets by one hash; each bucket then receives its own seed chosen so that every key lands in a distinct slot (hash & displace).
+/// Lookup costs one hash of the key, one table probe, and one string comparison regardless of the number of bindings.
+/// </summary>
+namespace key_index {
+
+// FNV-1a, evaluated once per looked up key
+constexpr std::uint64_t HashKey(std::string_view key) {
+    return fnv::Fold(fnv::offsetBasis, key);
+}
+
+// Cheap reseeding of an existing key hash
+constexpr std::uint64_t Mix(std::uint64_t hash, std::uint64_t seed) {
+    auto x = hash ^ (seed * 0x9e3779b97f4a7c15);
+    x ^= x >> 32;
+    x *= 0xd6e8feb86659fd93;
+    x ^= x >> 32;
+    return x;
+}
+
+constexpr std::size_t NextPowerOfTwo(std::size_t n) {
+    auto result = std::size_t{ 1 };
+    while (result < n) { result <<= 1; }
+    return result;
+}
+
+} // namespace key_index
+
+template <std::size_t N>
+class KEY_INDEX {
+public:
+    static constexpr std::size_t npos = N;
+
+    constexpr explicit KEY_INDEX(const std::array<std::string_view, N>& names) : names_{ names } {
+        // Group keys by bucket (counting sort) so each placement attempt only touches its own keys
+        auto hashes = std::array<std::uint64_t, N>{ };
+        auto isDuplicate = std::array<bool, N>{ };
+        auto bucketBegin = std::array<std::size_t, bucketCount + 1>{ };
+        for (auto i = std::size_t{ 0 }; i < N; ++i) {
+            hashes[i] = key_index::HashKey(names_[i]);
+            for (auto j = std::size_t{ 0 }; j < i; ++j) {
+                if (names_[j] == names_[i]) { isDuplicate[i] = true; } // First binding with a given name wins
+            }
+            if (!isDuplicate[i]) { ++bucketBegin[BucketOf(hashes[i]) + 1]; }
+        }
+        for (auto b = std::size_t{ 0 }; b < bucketCount; ++b) { bucketBegin[b + 1] += bucketBegin[b]; }
+        auto members = std::array<std::size_t, N>{ };
+        auto fill = bucketBegin;
+        for (auto i = std::size_t{ 0 }; i < N; ++i) {
+            if (!isDuplicate[i]) { members[fill[BucketOf(hashes[i])]++] = i; }
+        }
+        for (auto& slot : slots_) { slot = npos; }
+
+        // Place the most crowded buckets first while the table is still sparse
+        auto isPlaced = std::array<bool, bucketCount>{ };
+        for (auto placed = std::size_t{ 0 }; placed < bucketCount; ++placed) {
+            auto bucket = std::size_t{ 0 };
+            for (auto b = std::size_t{ 0 }; b < bucketCount; ++b) {
+                const auto size = bucketBegin[b + 1] - bucketBegin[b];
+                if (!isPlaced[b] && (isPlaced[bucket] || size > bucketBegin[bucket + 1] - bucketBegin[bucket])) { bucket = b; }
+            }
+            isPlaced[bucket] = true;
+
+            auto seed = std::uint64_t{ 0 };
+            while (!TryPlace(hashes, members, bucketBegin[bucket], bucketBegin[bucket + 1], seed)) {
+                if (++seed > maxSeed) { throw std::logic_error{ "Unable to build perfect hash: binding names collide." }; }
+            }
+            seeds_[bucket] = seed;
+        }
+    }
+
+    // Index of the binding with the given name, or npos when the key is unrecognized
+    [[nodiscard]] constexpr std::size_t find(std::string_view key) const {
+        if constexpr (N == 0) {
+            return npos;
+        }
+        else {
+            const auto hash = key_index::HashKey(key);
+            const auto index = slots_[SlotOf(hash, seeds_[BucketOf(hash)])];
+            return (index != npos && names_[index] == key) ? index : npos;
+        }
+    }
+
+private:
+    static constexpr std::size_t slotCount = key_index::NextPowerOfTwo(2 * N); // Load factor of at most one half
+    static constexpr std::size_t bucketCount = key_index::NextPowerOfTwo((N + 1) / 2);
+    static constexpr std::uint64_t maxSeed = 1 << 16;
+
+    static constexpr std::size_t BucketOf(std::uint64_t hash) {
+        return static_cast<std::size_t>(key_index::Mix(hash, 0) >> 32) & (bucketCount - 1);
+    }
+
+    static constexpr std::size_t SlotOf(std::uint64_t hash, std::uint64_t seed) {
+        return static_cast<std::size_t>(key_index::Mix(hash, seed)) & (slotCount - 1);
+    }
+
+    // Claim one free slot per key in the bucket, or leave the table untouched if any two keys collide
+    constexpr bool TryPlace(const std::array<std::uint64_t, N>& hashes, const std::array<std::size_t, N>& members, std::size_t begin, std::size_t end, std::uint64_t seed) {
+        for (auto m = begin; m < end; ++m) {
+            const auto slot = SlotOf(hashes[members[m]], seed);
+            if (slots_[slot] != npos) {
+                for (auto undo = begin; undo < m; ++undo) { slots_[SlotOf(hashes[members[undo]], seed)] = npos; }
+                return false;
+            }
+            slots_[slot] = members[m];
+        }
+        return true;
+    }
+
+    std::array<std::string_view, N> names_{ };
+    std::array<std::uint64_t, bucketCount> seeds_{ };
+    std::array<std::size_t, slotCount> slots_{ };
+};
+
+// Build the key index from a member mapping tuple, e.g. T::DefineMemberMapping()
+template <class... BINDINGS>
+constexpr KEY_INDEX<sizeof...(BINDINGS)> MakeKeyIndex(const std::tuple<BINDINGS...>& mapping) {
+    auto names = std::array<std::string_view, sizeof...(BINDINGS)>{ };
+    auto index = std::size_t{ 0 };
+    std::apply([&names, &index](auto &&...element) { ((names[index++] = element.name_), ...); }, mapping);
+    return KEY_INDEX<sizeof...(BINDINGS)>{ names };
+}
+
+// One key index per mapped type, built entirely at compile time
+template <class T>
+inline constexpr auto keyIndex = MakeKeyIndex(T::DefineMemberMapping());
+
+#endif // !SERIAL_KEY_INDEX_HPP
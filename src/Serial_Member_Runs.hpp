@@ -0,0 +1,335 @@
+#ifndef SERIAL_MEMBER_RUNS_HPP
+#define SERIAL_MEMBER_RUNS_HPP 1
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "Serial_Type_Traits.hpp"
+
+/// <summary>
+/// Memberwise equality, three-way ordering and hashing driven by DefineMemberMapping().
+/// Mapped members whose value is fully determined by their bytes (integral & enum types) are bitwise comparable.
+/// Consecutive bitwise comparable mappings which also sit back to back in memory (no padding between them) form a run,
+/// and a run is compared or hashed as one contiguous block of bytes instead of member by member.
+/// Which members are bitwise comparable is decided at compile time; member offsets are taken once per type, the first time it is compared or hashed.
+/// </summary>
+namespace member_runs {
+
+template <class T>
+inline constexpr bool isBitwiseComparable = std::is_integral_v<T> || std::is_enum_v<T>;
+
+template <class T, class ELEMENT>
+using MemberType = std::decay_t<decltype(std::declval<const T&>().*(std::declval<ELEMENT>().member_))>;
+
+template <class T>
+inline constexpr std::size_t mappingSize = std::tuple_size_v<decltype(T::DefineMemberMapping())>;
+
+template <std::size_t N> struct Layout {
+    std::array<std::size_t, N> offsets{ };
+    std::array<std::size_t, N> runBytes{ }; // Bytes covered by the run starting at this member; zero when no run starts here
+    std::array<std::size_t, N> runEnd{ }; // Index one past the last member of the run starting at this member
+    std::array<bool, N> inRun{ };
+};
+
+inline const char* BytesOf(const void* object) {
+    return static_cast<const char*>(object);
+}
+
+inline std::uint64_t Load64(const char* source) {
+    auto value = std::uint64_t{ };
+    std::memcpy(&value, source, sizeof(value));
+    return value;
+}
+
+// Shorter runs compare faster member by member, which compilers inline & vectorize, than through a memcmp call
+inline constexpr std::size_t minCollapsedRunBytes = 64;
+
+// Locate the runs of a mapped type, using 'object' to take member offsets
+template <class T> Layout<mappingSize<T>> LayoutOf(const T& object) {
+    constexpr auto N = mappingSize<T>;
+    auto layout = Layout<N>{ };
+    auto sizes = std::array<std::size_t, N>{ };
+    auto index = std::size_t{ 0 };
+    auto Measure = [&layout, &sizes, &index, &object](auto&& element) {
+        using MEMBER = MemberType<T, decltype(element)>;
+        layout.offsets[index] = static_cast<std::size_t>(BytesOf(&(object.*(element.member_))) - BytesOf(&object));
+        sizes[index] = sizeof(MEMBER);
+        layout.inRun[index] = isBitwiseComparable<MEMBER>;
+        ++index;
+    };
+    std::apply([&Measure](auto &&...element) { (Measure(element), ...); }, T::DefineMemberMapping());
+
+    // Walk backwards so each run start accumulates everything that follows it
+    for (auto i = N; i-- > 0;) {
+        if (!layout.inRun[i]) { continue; }
+        layout.runBytes[i] = sizes[i];
+        layout.runEnd[i] = i + 1;
+        if (i + 1 < N && layout.inRun[i + 1] && layout.offsets[i + 1] == layout.offsets[i] + sizes[i]) {
+            layout.runBytes[i] += layout.runBytes[i + 1];
+            layout.runEnd[i] = layout.runEnd[i + 1];
+            layout.runBytes[i + 1] = 0;
+        }
+    }
+    return layout;
+}
+
+// Compiled runs: byte blocks to memcmp, interleaved with the members outside any run
+struct Step {
+    std::size_t offset{ 0 };
+    std::size_t bytes{ 0 }; // Zero for a single member outside any run
+    std::size_t first{ 0 }; // Mapping index of the first member covered
+    std::size_t end{ 0 }; // Mapping index one past the last member covered
+};
+
+template <std::size_t N> struct Plan {
+    std::array<Step, N> steps{ };
+    std::size_t stepCount{ 0 };
+    bool isCollapsedComparisonFaster{ false }; // Some run is long enough to compare faster as one block
+};
+
+template <class T> Plan<mappingSize<T>> MakePlan(const T& object) {
+    const auto layout = LayoutOf(object);
+    auto plan = Plan<mappingSize<T>>{ };
+    for (auto i = std::size_t{ 0 }; i < mappingSize<T>; ++i) {
+        if (!layout.inRun[i]) { plan.steps[plan.stepCount++] = Step{ 0, 0, i, i + 1 }; }
+        else if (layout.runBytes[i] != 0) { plan.steps[plan.stepCount++] = Step{ layout.offsets[i], layout.runBytes[i], i, layout.runEnd[i] }; }
+        plan.isCollapsedComparisonFaster = plan.isCollapsedComparisonFaster || layout.runBytes[i] >= minCollapsedRunBytes;
+    }
+    return plan;
+}
+
+// Member offsets are the same for every object of a type, so the plan is built once from whichever object comes first
+template <class T> const Plan<mappingSize<T>>& PlanOf(const T& object) {
+    static const auto plan = MakePlan(object);
+    return plan;
+}
+
+template <class T, std::size_t I>
+using MemberAt = MemberType<T, std::tuple_element_t<I, decltype(T::DefineMemberMapping())>>;
+
+template <class T, std::size_t... I> constexpr bool HasAdjacentBitwise(std::index_sequence<I...>) {
+    constexpr bool isBitwise[] = { isBitwiseComparable<MemberAt<T, I>>..., false };
+    for (auto i = std::size_t{ 0 }; i + 1 < sizeof...(I); ++i) {
+        if (isBitwise[i] && isBitwise[i + 1]) { return true; }
+    }
+    return false;
+}
+
+// Only mappings with two consecutive bitwise comparable members can form a run worth a memcmp
+template <class T>
+inline constexpr bool hasRuns = HasAdjacentBitwise<T>(std::make_index_sequence<mappingSize<T>>{ });
+
+///////////////////////
+
+template <class T> int Compare(const T& lhs, const T& rhs);
+
+// Negative, zero or positive as lhs orders before, equivalent to, or after rhs
+template <class T> constexpr int CompareValue(const T& lhs, const T& rhs) {
+    using TYPE = std::decay_t<T>;
+
+    if constexpr (std::is_same_v<TYPE, std::string_view> || std::is_same_v<TYPE, std::string>) {
+        const auto result = lhs.compare(rhs);
+        return (result > 0) - (result < 0);
+    }
+    else if constexpr (serializable::traits::hasMemberMapping<TYPE>) {
+        return Compare(lhs, rhs);
+    }
+    else {
+        return (rhs < lhs) - (lhs < rhs);
+    }
+}
+
+// Member by member, for constant evaluation and for mappings without runs
+template <class T> constexpr bool EqualMemberwise(const T& lhs, const T& rhs) {
+    return std::apply([&lhs, &rhs](auto &&...element) { return ((lhs.*(element.member_) == rhs.*(element.member_)) && ...); }, T::DefineMemberMapping());
+}
+
+template <class T> constexpr int CompareMemberwise(const T& lhs, const T& rhs) {
+    auto result = 0;
+    auto CompareElement = [&lhs, &rhs](auto&& element) -> int {
+        using MEMBER = MemberType<T, decltype(element)>;
+        if constexpr (serializable::traits::hasMemberMapping<MEMBER>) { return CompareMemberwise(lhs.*(element.member_), rhs.*(element.member_)); }
+        else { return CompareValue(lhs.*(element.member_), rhs.*(element.member_)); }
+    };
+    std::apply([&CompareElement, &result](auto &&...element) { static_cast<void>((((result = CompareElement(element)) == 0) && ...)); }, T::DefineMemberMapping());
+    return result;
+}
+
+// Per-member operations addressed by mapping index, for members the plan visits one at a time
+template <class T, std::size_t I> bool EqualAt(const T& lhs, const T& rhs) {
+    constexpr auto member = std::get<I>(T::DefineMemberMapping()).member_;
+    return lhs.*member == rhs.*member;
+}
+
+template <class T, std::size_t I> int CompareAt(const T& lhs, const T& rhs) {
+    constexpr auto member = std::get<I>(T::DefineMemberMapping()).member_;
+    return CompareValue(lhs.*member, rhs.*member);
+}
+
+template <class T, std::size_t... I> constexpr auto MakeEqualTable(std::index_sequence<I...>) {
+    return std::array<bool (*)(const T&, const T&), sizeof...(I)>{ &EqualAt<T, I>... };
+}
+
+template <class T, std::size_t... I> constexpr auto MakeCompareTable(std::index_sequence<I...>) {
+    return std::array<int (*)(const T&, const T&), sizeof...(I)>{ &CompareAt<T, I>... };
+}
+
+template <class T> bool Equal(const T& lhs, const T& rhs) {
+    if constexpr (!hasRuns<T>) {
+        return EqualMemberwise(lhs, rhs);
+    }
+    else {
+        static constexpr auto equalAt = MakeEqualTable<T>(std::make_index_sequence<mappingSize<T>>{ });
+        const auto& plan = PlanOf(lhs);
+        if (!plan.isCollapsedComparisonFaster) { return EqualMemberwise(lhs, rhs); }
+        for (auto s = std::size_t{ 0 }; s < plan.stepCount; ++s) {
+            const auto& step = plan.steps[s];
+            if (step.bytes == 0 ? !equalAt[step.first](lhs, rhs) : std::memcmp(BytesOf(&lhs) + step.offset, BytesOf(&rhs) + step.offset, step.bytes) != 0) { return false; }
+        }
+        return true;
+    }
+}
+
+// Members of a run are only compared one by one once the run as a whole is known to differ
+template <class T> int Compare(const T& lhs, const T& rhs) {
+    if constexpr (!hasRuns<T>) {
+        return CompareMemberwise(lhs, rhs);
+    }
+    else {
+        static constexpr auto compareAt = MakeCompareTable<T>(std::make_index_sequence<mappingSize<T>>{ });
+        const auto& plan = PlanOf(lhs);
+        if (!plan.isCollapsedComparisonFaster) { return CompareMemberwise(lhs, rhs); }
+        for (auto s = std::size_t{ 0 }; s < plan.stepCount; ++s) {
+            const auto& step = plan.steps[s];
+            if (step.bytes != 0 && std::memcmp(BytesOf(&lhs) + step.offset, BytesOf(&rhs) + step.offset, step.bytes) == 0) { continue; }
+            for (auto i = step.first; i < step.end; ++i) {
+                const auto result = compareAt[i](lhs, rhs);
+                if (result != 0) { return result; }
+            }
+        }
+        return 0;
+    }
+}
+
+///////////////////////
+
+inline constexpr std::uint64_t prime1 = 0x9e3779b185ebca87;
+inline constexpr std::uint64_t prime2 = 0xc2b2ae3d27d4eb4f;
+inline constexpr std::uint64_t prime3 = 0x165667b19e3779f9;
+
+inline std::uint64_t RotateLeft(std::uint64_t x, int bits) {
+    return (x << bits) | (x >> (64 - bits));
+}
+
+inline std::uint64_t Round(std::uint64_t accumulator, std::uint64_t input) {
+    return RotateLeft(accumulator + input * prime2, 31) * prime1;
+}
+
+// Fast non-cryptographic hash of a byte range. Long inputs are consumed 32 bytes at a time by four independent lanes,
+// so the multiplies of consecutive words overlap instead of forming one serial dependency chain.
+inline std::uint64_t HashBytes(const char* data, std::size_t size, std::uint64_t seed) {
+    const auto* const end = data + size;
+    auto hash = seed + prime3 + size * prime1;
+    if (size >= 32) {
+        auto lane1 = seed + prime1 + prime2;
+        auto lane2 = seed + prime2;
+        auto lane3 = seed;
+        auto lane4 = seed - prime1;
+        for (; end - data >= 32; data += 32) {
+            lane1 = Round(lane1, Load64(data));
+            lane2 = Round(lane2, Load64(data + 8));
+            lane3 = Round(lane3, Load64(data + 16));
+            lane4 = Round(lane4, Load64(data + 24));
+        }
+        hash += RotateLeft(lane1, 1) + RotateLeft(lane2, 7) + RotateLeft(lane3, 12) + RotateLeft(lane4, 18);
+    }
+    for (; end - data >= 8; data += 8) { hash = RotateLeft(hash ^ Round(0, Load64(data)), 27) * prime1 + prime2; }
+    for (; data < end; ++data) { hash = RotateLeft(hash ^ (static_cast<unsigned char>(*data) * prime3), 11) * prime1; }
+
+    // Avalanche so every input bit affects every output bit
+    hash ^= hash >> 33;
+    hash *= prime2;
+    hash ^= hash >> 29;
+    hash *= prime3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+inline std::uint64_t Combine(std::uint64_t seed, std::uint64_t value) {
+    return Round(seed, value);
+}
+
+template <class T> std::uint64_t Hash(const T& object, std::uint64_t seed);
+
+// Hash consistent with operator==: equal values hash equally
+template <class T> std::uint64_t HashValue(const T& value, std::uint64_t seed) {
+    using namespace serializable::traits;
+
+    if constexpr (isOptional<T>) {
+        return value.has_value() ? HashValue(value.value(), Combine(seed, 1)) : Combine(seed, 0);
+    }
+    else if constexpr (std::is_same_v<T, std::string_view> || std::is_same_v<T, std::string>) {
+        return HashBytes(value.data(), value.size(), seed);
+    }
+    else if constexpr (isBitwiseComparable<T>) {
+        return HashBytes(BytesOf(&value), sizeof(T), seed);
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+        const auto normalized = value == T{ 0 } ? T{ 0 } : value; // -0.0 == 0.0
+        return HashBytes(BytesOf(&normalized), sizeof(T), seed);
+    }
+    else if constexpr (hasMemberMapping<T>) {
+        return Hash(value, seed);
+    }
+    else if constexpr (isContainer<T>) {
+        auto hash = Combine(seed, value.size());
+        for (const auto& element : value) {
+            if constexpr (isMap<T>) { hash = HashValue(element.second, HashValue(element.first, hash)); }
+            else { hash = HashValue(element, hash); }
+        }
+        return hash;
+    }
+    else {
+        return Combine(seed, std::hash<T>{ }(value));
+    }
+}
+
+template <class T, std::size_t I> std::uint64_t HashAt(const T& object, std::uint64_t seed) {
+    constexpr auto member = std::get<I>(T::DefineMemberMapping()).member_;
+    return HashValue(object.*member, seed);
+}
+
+template <class T, std::size_t... I> constexpr auto MakeHashTable(std::index_sequence<I...>) {
+    return std::array<std::uint64_t (*)(const T&, std::uint64_t), sizeof...(I)>{ &HashAt<T, I>... };
+}
+
+template <class T> std::uint64_t Hash(const T& object, std::uint64_t seed) {
+    if constexpr (!hasRuns<T>) {
+        return std::apply([&object, seed](auto &&...element) {
+            auto hash = seed;
+            ((hash = HashValue(object.*(element.member_), hash)), ...);
+            return hash;
+            }, T::DefineMemberMapping());
+    }
+    else {
+        static constexpr auto hashAt = MakeHashTable<T>(std::make_index_sequence<mappingSize<T>>{ });
+        const auto& plan = PlanOf(object);
+        auto hash = seed;
+        for (auto s = std::size_t{ 0 }; s < plan.stepCount; ++s) {
+            const auto& step = plan.steps[s];
+            hash = step.bytes == 0 ? hashAt[step.first](object, hash) : HashBytes(BytesOf(&object) + step.offset, step.bytes, hash);
+        }
+        return hash;
+    }
+}
+
+} // namespace member_runs
+
+#endif // !SERIAL_MEMBER_RUNS_HPP
@@ -0,0 +1,210 @@
+#ifndef SERIAL_NUMBER_HPP
+#define SERIAL_NUMBER_HPP 1
+
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include "Utilities_Limited_Constexpr.hpp"
+
+/// <summary>
+/// Number to text and back without allocating.
+/// Integers are written two digits at a time from a table of digit pairs, and read eight digits at a time by treating
+/// eight characters as one 64-bit word (SWAR), with overflow detected against the range of the destination type.
+/// Integer and bool conversions are constexpr; float & double go through std::to_chars / std::from_chars
+/// (shortest round-trip form), which cannot be evaluated at compile time before C++23.
+/// </summary>
+namespace number {
+
+// Arithmetic types written as numbers; char stays a single character
+template <class T>
+inline constexpr bool isNumber = std::is_arithmetic_v<T> && !std::is_same_v<T, char>;
+
+template <class T>
+inline constexpr bool isInteger = std::is_integral_v<T> && !std::is_same_v<T, char> && !std::is_same_v<T, bool>;
+
+// Longest text form of a value of type T
+template <class T> constexpr std::size_t MaxChars() {
+    if constexpr (std::is_same_v<T, bool>) { return 5; } // "false"
+    else if constexpr (std::is_same_v<T, float>) { return 15; } // e.g. "-1.17549435e-38"
+    else if constexpr (std::is_floating_point_v<T>) { return 24; } // e.g. "-2.2250738585072014e-308"
+    else { return std::numeric_limits<T>::digits10 + 1 + std::is_signed_v<T>; } // Digits plus sign
+}
+
+template <class T>
+inline constexpr std::size_t maxChars = MaxChars<T>();
+
+// "00", "01", ... "99"
+inline constexpr auto digitPairs = [] {
+    auto pairs = std::array<char, 200>{ };
+    for (auto i = 0; i < 100; ++i) {
+        pairs[2 * i] = static_cast<char>('0' + i / 10);
+        pairs[2 * i + 1] = static_cast<char>('0' + i % 10);
+    }
+    return pairs;
+}();
+
+// Unsigned working type: 32-bit division is cheaper, so narrow types never use 64-bit arithmetic
+template <class INTEGRAL>
+using Magnitude = std::conditional_t<(sizeof(INTEGRAL) <= sizeof(std::uint32_t)), std::uint32_t, std::uint64_t>;
+
+template <class UNSIGNED> constexpr std::size_t DigitCount(UNSIGNED value) {
+    auto count = std::size_t{ 1 };
+    for (;;) { // Four digits per division
+        if (value < 10) { return count; }
+        if (value < 100) { return count + 1; }
+        if (value < 1000) { return count + 2; }
+        if (value < 10000) { return count + 3; }
+        value /= 10000;
+        count += 4;
+    }
+}
+
+// Write the digits of 'value' so that they end just before 'last', two at a time
+template <class UNSIGNED> constexpr void WriteDigits(char* last, UNSIGNED value) {
+    while (value >= 100) {
+        const auto pair = static_cast<std::size_t>(value % 100) * 2;
+        value /= 100;
+        *--last = digitPairs[pair + 1];
+        *--last = digitPairs[pair];
+    }
+    if (value >= 10) {
+        *--last = digitPairs[static_cast<std::size_t>(value) * 2 + 1];
+        *--last = digitPairs[static_cast<std::size_t>(value) * 2];
+    }
+    else {
+        *--last = static_cast<char>('0' + value);
+    }
+}
+
+template <class INTEGRAL> constexpr Magnitude<INTEGRAL> MagnitudeOf(INTEGRAL value) {
+    using MAGNITUDE = Magnitude<INTEGRAL>;
+    if constexpr (std::is_signed_v<INTEGRAL>) {
+        if (value < 0) { return MAGNITUDE{ 0 } - static_cast<MAGNITUDE>(value); } // Modular, so well defined for the most negative value as well
+    }
+    return static_cast<MAGNITUDE>(value);
+}
+
+// Number of characters ToChars() writes for an integer, including any sign
+template <class INTEGRAL> constexpr std::size_t ToCharsLength(INTEGRAL value) {
+    if constexpr (std::is_signed_v<INTEGRAL>) {
+        return (value < 0 ? 1 : 0) + DigitCount(MagnitudeOf(value));
+    }
+    else {
+        return DigitCount(MagnitudeOf(value));
+    }
+}
+
+// Integer, bool or floating point value written at 'first', which must have room for maxChars<T> characters. Returns one past the last character written.
+template <class T> constexpr char* ToChars(char* first, T value) {
+    if constexpr (std::is_same_v<T, bool>) {
+        const auto text = value ? std::string_view{ "true" } : std::string_view{ "false" };
+        for (auto c : text) { *first++ = c; }
+        return first;
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+        return std::to_chars(first, first + maxChars<T>, value).ptr;
+    }
+    else {
+        if constexpr (std::is_signed_v<T>) {
+            if (value < 0) { *first++ = '-'; }
+        }
+        const auto magnitude = MagnitudeOf(value);
+        const auto length = DigitCount(magnitude);
+        WriteDigits(first + length, magnitude);
+        return first + length;
+    }
+}
+
+///////////////////////
+
+// Eight characters as one little-endian word, first character in the lowest byte, whatever the platform byte order
+constexpr std::uint64_t LoadEight(const char* first) {
+    auto word = std::uint64_t{ 0 };
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if (!limited_constexpr::IsConstantEvaluated()) {
+        std::memcpy(&word, first, sizeof(word)); // One unaligned load
+        return word;
+    }
+#endif
+    for (auto i = 0; i < 8; ++i) { word |= static_cast<std::uint64_t>(static_cast<unsigned char>(first[i])) << (8 * i); }
+    return word;
+}
+
+// Whether all eight bytes are '0'...'9': each byte's high nibble must be 3, and adding 6 must not carry into it
+constexpr bool IsEightDigits(std::uint64_t word) {
+    return ((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+// Value of eight digits loaded by LoadEight(), combining neighbouring digits, then pairs, then quads, in three multiplies
+constexpr std::uint64_t ParseEight(std::uint64_t word) {
+    word -= 0x3030303030303030;
+    word = (word * 10) + (word >> 8);
+    word = (((word & 0x000000FF000000FF) * (100 + (1000000ULL << 32))) + (((word >> 16) & 0x000000FF000000FF) * (1 + (10000ULL << 32)))) >> 32;
+    return word;
+}
+
+// Digits only, at most twenty significant ones; nullopt on any other character or when the value exceeds 64 bits
+constexpr std::optional<std::uint64_t> ParseDigits(const char* first, const char* last) {
+    if (first == last) { return std::nullopt; }
+    while (last - first > 1 && *first == '0') { ++first; } // Leading zeros do not count towards the limit
+    if (last - first > std::numeric_limits<std::uint64_t>::digits10 + 1) { return std::nullopt; }
+    const auto mayOverflow = last - first == std::numeric_limits<std::uint64_t>::digits10 + 1;
+
+    auto value = std::uint64_t{ 0 };
+    for (; last - first >= 8; first += 8) { // At most 16 digits here, far below overflow
+        const auto word = LoadEight(first);
+        if (!IsEightDigits(word)) { return std::nullopt; }
+        value = value * 100000000 + ParseEight(word);
+    }
+    for (; first != last; ++first) {
+        const auto digit = static_cast<unsigned char>(*first - '0');
+        if (digit > 9) { return std::nullopt; }
+        if (mayOverflow && value > (std::numeric_limits<std::uint64_t>::max() - digit) / 10) { return std::nullopt; }
+        value = value * 10 + digit;
+    }
+    return value;
+}
+
+// Text written by ToChars() back to a value; nullopt unless the whole range is one well-formed value in range of T
+template <class T> constexpr std::optional<T> FromChars(const char* first, const char* last) {
+    if constexpr (std::is_same_v<T, bool>) {
+        const auto text = std::string_view{ first, static_cast<std::size_t>(last - first) };
+        if (text == "true") { return true; }
+        if (text == "false") { return false; }
+        return std::nullopt;
+    }
+    else if constexpr (std::is_floating_point_v<T>) {
+        auto value = T{ };
+        const auto result = std::from_chars(first, last, value);
+        if (result.ec != std::errc{ } || result.ptr != last) { return std::nullopt; }
+        return value;
+    }
+    else {
+        auto isNegative = false;
+        if constexpr (std::is_signed_v<T>) {
+            if (first != last && *first == '-') {
+                isNegative = true;
+                ++first;
+            }
+        }
+        const auto magnitude = ParseDigits(first, last);
+        if (!magnitude.has_value()) { return std::nullopt; }
+
+        using UNSIGNED = std::make_unsigned_t<T>;
+        const auto limit = static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (isNegative ? 1 : 0);
+        if (*magnitude > limit) { return std::nullopt; }
+        const auto bits = static_cast<UNSIGNED>(*magnitude);
+        return static_cast<T>(isNegative ? static_cast<UNSIGNED>(UNSIGNED{ 0 } - bits) : bits);
+    }
+}
+
+} // namespace number
+
+#endif // !SERIAL_NUMBER_HPP
@@ -0,0 +1,364 @@
+#ifndef SERIAL_RECORD_LOG_HPP
+#define SERIAL_RECORD_LOG_HPP 1
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Serial_Binary_CRTP.hpp"
+#include "Serial_CRTP.hpp"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// <summary>
+/// Append-only file of serialized records, read back through a memory mapping.
+/// Each record is framed by a 4-byte little-endian length followed by its text. A sidecar "<path>.index" holds the 8-byte little-endian
+/// offset of every frame, so record i is found without scanning. After a crash, trailing index entries which do not point where the previous
+/// frame ends (past the end of the data, or left zero-filled) are ignored, frames written after the last good index entry are recovered by scanning,
+/// and a torn final frame is ignored by readers and cut off by writers. A corrupt entry in the middle of the index makes reads of it throw.
+/// Readers hand out std::string_view records pointing into the mapping: deserializing them copies nothing the type does not own,
+/// and std::string_view members of the objects stay valid for as long as the reader.
+/// </summary>
+namespace record_log {
+
+using FrameLength = std::uint32_t;
+using Offset = std::uint64_t;
+
+inline constexpr std::size_t lengthSize = sizeof(FrameLength);
+inline constexpr std::size_t offsetSize = sizeof(Offset);
+
+inline std::string IndexPath(const std::string& path) {
+    return path + ".index";
+}
+
+// End of the frame starting at 'offset', or std::nullopt when the frame is incomplete, e.g. torn by a crash mid-append.
+// Serialized records are never empty, so a zero length (e.g. a zero-filled tail after a crash) is not a frame either.
+inline std::optional<std::uint64_t> FrameEnd(std::string_view data, std::uint64_t offset) {
+    if (offset > data.size() || data.size() - offset < lengthSize) { return std::nullopt; }
+    const auto length = binary::LoadLittleEndian<FrameLength>(data.data() + offset);
+    if (length == 0 || length > data.size() - offset - lengthSize) { return std::nullopt; }
+    return offset + lengthSize + length;
+}
+
+// Whole file mapped read-only; an empty file maps to an empty view
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path) {
+#ifdef _WIN32
+        file_ = ::CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) { throw std::runtime_error{ "Error opening record log: " + path }; }
+        auto size = LARGE_INTEGER{ };
+        if (!::GetFileSizeEx(file_, &size)) {
+            close();
+            throw std::runtime_error{ "Error opening record log: " + path };
+        }
+        size_ = static_cast<std::size_t>(size.QuadPart);
+        if (size_ == 0) { return; }
+        mapping_ = ::CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        data_ = mapping_ != nullptr ? static_cast<const char*>(::MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0)) : nullptr;
+#else
+        const auto descriptor = ::open(path.c_str(), O_RDONLY);
+        if (descriptor < 0) { throw std::runtime_error{ "Error opening record log: " + path }; }
+        struct stat status { };
+        if (::fstat(descriptor, &status) != 0) {
+            ::close(descriptor);
+            throw std::runtime_error{ "Error opening record log: " + path };
+        }
+        size_ = static_cast<std::size_t>(status.st_size);
+        if (size_ == 0) {
+            ::close(descriptor);
+            return;
+        }
+        auto* address = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, descriptor, 0);
+        ::close(descriptor); // The mapping keeps the file open
+        data_ = address != MAP_FAILED ? static_cast<const char*>(address) : nullptr;
+#endif
+        if (data_ == nullptr) {
+            close();
+            throw std::runtime_error{ "Error mapping record log: " + path };
+        }
+    }
+
+    MappedFile(MappedFile&& other) noexcept { swap(other); }
+
+    MappedFile& operator=(MappedFile&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() { close(); }
+
+    [[nodiscard]] std::string_view bytes() const { return data_ != nullptr ? std::string_view{ data_, size_ } : std::string_view{ }; }
+
+private:
+    void swap(MappedFile& other) noexcept {
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+#ifdef _WIN32
+        std::swap(file_, other.file_);
+        std::swap(mapping_, other.mapping_);
+#endif
+    }
+
+    void close() noexcept {
+#ifdef _WIN32
+        if (data_ != nullptr) { ::UnmapViewOfFile(data_); }
+        if (mapping_ != nullptr) { ::CloseHandle(mapping_); }
+        if (file_ != INVALID_HANDLE_VALUE) { ::CloseHandle(file_); }
+        mapping_ = nullptr;
+        file_ = INVALID_HANDLE_VALUE;
+#else
+        if (data_ != nullptr) { ::munmap(const_cast<char*>(data_), size_); }
+#endif
+        data_ = nullptr;
+        size_ = 0;
+    }
+
+    const char* data_{ nullptr };
+    std::size_t size_{ 0 };
+#ifdef _WIN32
+    HANDLE file_{ INVALID_HANDLE_VALUE };
+    HANDLE mapping_{ nullptr };
+#endif
+};
+
+struct FileCloser {
+    void operator()(std::FILE* file) const { std::fclose(file); }
+};
+
+using FilePointer = std::unique_ptr<std::FILE, FileCloser>;
+
+inline std::uint64_t IndexEntry(std::string_view index, std::size_t i) {
+    return binary::LoadLittleEndian<Offset>(index.data() + i * offsetSize);
+}
+
+// Whether index entry i is where the log puts frame i: a complete frame, starting at 0 for the first entry and where the previous frame ends for the others.
+// Garbage entries, such as a zero-filled tail left by a crash after the index grew, fail the check even when they happen to point at a valid frame.
+inline bool IsTrustedEntry(std::string_view data, std::string_view index, std::size_t i) {
+    const auto offset = IndexEntry(index, i);
+    if (!FrameEnd(data, offset).has_value()) { return false; }
+    if (i == 0) { return offset == 0; }
+    const auto previousEnd = FrameEnd(data, IndexEntry(index, i - 1));
+    return previousEnd.has_value() && *previousEnd == offset;
+}
+
+// Number of leading index entries which can be trusted. Frames are appended in order, so only entries at the end can be missing
+// from the data or left unwritten; the earlier ones are not read, and are checked by the reader when used.
+inline std::size_t TrustedEntries(std::string_view data, std::string_view index) {
+    auto entries = index.size() / offsetSize;
+    while (entries > 0 && !IsTrustedEntry(data, index, entries - 1)) { --entries; }
+    return entries;
+}
+
+// End of the frames covered by the first 'entries' index entries
+inline std::uint64_t IndexedEnd(std::string_view data, std::string_view index, std::size_t entries) {
+    return entries == 0 ? 0 : *FrameEnd(data, IndexEntry(index, entries - 1));
+}
+
+// Offsets of the complete frames from 'offset' onwards, i.e. those appended after the index was last flushed
+inline std::vector<std::uint64_t> ScanFrames(std::string_view data, std::uint64_t offset) {
+    auto offsets = std::vector<std::uint64_t>{ };
+    for (auto end = FrameEnd(data, offset); end.has_value(); end = FrameEnd(data, offset)) {
+        offsets.push_back(offset);
+        offset = *end;
+    }
+    return offsets;
+}
+
+} // namespace record_log
+
+/// <summary>
+/// Appends records to a log, creating it if needed. Reopening an existing log first brings its index up to date with the data
+/// and cuts off a torn final frame, so a log survives a crash at any point of an append.
+/// Output is buffered; flush() makes every appended record visible to readers opened afterwards.
+/// A failed write leaves the data and index out of step, so the writer then rejects every further append() and flush();
+/// reopening the log recovers it, keeping the records which reached the data file.
+/// </summary>
+template <class T>
+class RecordLogWriter {
+public:
+    explicit RecordLogWriter(std::string path) : path_{ std::move(path) } {
+        Recover();
+        data_ = Open(path_);
+        index_ = Open(record_log::IndexPath(path_));
+    }
+
+    // Append one record; its position in the log is the size() before the call
+    void append(const T& record) {
+        CheckHealthy();
+        frame_.assign(record_log::lengthSize, '\0');
+        record.serializeInto(frame_);
+        const auto length = frame_.size() - record_log::lengthSize;
+        if (length > 0xFFFFFFFF) { throw std::length_error{ "Record too large for record log framing." }; }
+        binary::StoreLittleEndian(frame_.data(), static_cast<record_log::FrameLength>(length)); // In range, checked above
+
+        char entry[record_log::offsetSize];
+        binary::StoreLittleEndian<record_log::Offset>(entry, end_);
+        if (std::fwrite(frame_.data(), 1, frame_.size(), data_.get()) != frame_.size() || std::fwrite(entry, 1, sizeof(entry), index_.get()) != sizeof(entry)) {
+            failed_ = true;
+            throw std::runtime_error{ "Error writing record log: " + path_ };
+        }
+        end_ += frame_.size();
+        ++size_;
+    }
+
+    // Write buffered records out, data before index
+    void flush() {
+        CheckHealthy();
+        if (std::fflush(data_.get()) != 0 || std::fflush(index_.get()) != 0) {
+            failed_ = true;
+            throw std::runtime_error{ "Error writing record log: " + path_ };
+        }
+    }
+
+    // Number of records in the log, including those appended before this writer was opened
+    [[nodiscard]] std::size_t size() const { return size_; }
+
+private:
+    // After a failed write end_ may no longer match the data file, so later index entries would point at the wrong frames
+    void CheckHealthy() const {
+        if (failed_) { throw std::runtime_error{ "Error writing record log: " + path_ + " failed earlier, reopen it to recover." }; }
+    }
+
+    static record_log::FilePointer Open(const std::string& path) {
+        auto file = record_log::FilePointer{ std::fopen(path.c_str(), "ab") };
+        if (file == nullptr) { throw std::runtime_error{ "Error opening record log: " + path }; }
+        std::setvbuf(file.get(), nullptr, _IOFBF, 1 << 20); // Large sequential writes
+        return file;
+    }
+
+    // Bring an existing log to a consistent state: drop index entries past the data, index frames appended after the index was last flushed,
+    // and truncate a torn final frame. Only the end of each file is read.
+    void Recover() {
+        const auto indexPath = record_log::IndexPath(path_);
+        if (!std::filesystem::exists(path_)) {
+            std::filesystem::remove(indexPath);
+            return;
+        }
+        auto entries = std::size_t{ 0 };
+        auto unindexed = std::vector<std::uint64_t>{ };
+        {
+            const auto data = record_log::MappedFile{ path_ };
+            auto index = std::optional<record_log::MappedFile>{ };
+            if (std::filesystem::exists(indexPath)) { index.emplace(indexPath); }
+            const auto indexBytes = index.has_value() ? index->bytes() : std::string_view{ };
+            entries = record_log::TrustedEntries(data.bytes(), indexBytes);
+            end_ = record_log::IndexedEnd(data.bytes(), indexBytes, entries);
+            unindexed = record_log::ScanFrames(data.bytes(), end_);
+            if (!unindexed.empty()) { end_ = *record_log::FrameEnd(data.bytes(), unindexed.back()); }
+        } // Unmapped before resizing
+        size_ = entries + unindexed.size();
+
+        if (std::filesystem::file_size(path_) != end_) { std::filesystem::resize_file(path_, end_); }
+        if (std::filesystem::exists(indexPath) && std::filesystem::file_size(indexPath) != entries * record_log::offsetSize) {
+            std::filesystem::resize_file(indexPath, entries * record_log::offsetSize);
+        }
+        if (unindexed.empty()) { return; }
+        auto index = Open(indexPath);
+        char entry[record_log::offsetSize];
+        for (auto offset : unindexed) {
+            binary::StoreLittleEndian<record_log::Offset>(entry, offset);
+            if (std::fwrite(entry, 1, sizeof(entry), index.get()) != sizeof(entry)) { throw std::runtime_error{ "Error writing record log: " + indexPath }; }
+        }
+        if (std::fflush(index.get()) != 0) { throw std::runtime_error{ "Error writing record log: " + indexPath }; }
+    }
+
+    std::string path_;
+    record_log::FilePointer data_;
+    record_log::FilePointer index_;
+    std::string frame_{ }; // Reused for every record
+    std::uint64_t end_{ 0 }; // Offset of the next frame
+    std::size_t size_{ 0 };
+    bool failed_{ false }; // Set by a failed write, see CheckHealthy()
+};
+
+/// <summary>
+/// Read-only view of a log through a memory mapping: records are looked up by index in O(1) or scanned in order, without read() copies.
+/// Sees the records flushed before it was opened. Records, and objects with std::string_view members decoded from them,
+/// refer into the mapping and are valid for the lifetime of the reader.
+/// </summary>
+template <class T>
+class RecordLogReader {
+public:
+    explicit RecordLogReader(const std::string& path) : data_{ path } {
+        const auto indexPath = record_log::IndexPath(path);
+        if (std::filesystem::exists(indexPath)) { index_.emplace(indexPath); }
+        const auto indexBytes = index_.has_value() ? index_->bytes() : std::string_view{ };
+
+        // Indexed frames are looked up straight from the mapped index; only frames it lacks are kept in memory
+        indexed_ = record_log::TrustedEntries(data_.bytes(), indexBytes);
+        unindexed_ = record_log::ScanFrames(data_.bytes(), record_log::IndexedEnd(data_.bytes(), indexBytes, indexed_));
+    }
+
+    [[nodiscard]] std::size_t size() const { return indexed_ + unindexed_.size(); }
+
+    // Serialized text of record i
+    [[nodiscard]] std::string_view record(std::size_t i) const {
+        if (i >= size()) { throw std::out_of_range{ "Record log index out of range." }; }
+        return FrameAt(OffsetOf(i));
+    }
+
+    [[nodiscard]] T get(std::size_t i) const {
+        return T::deserialize(record(i));
+    }
+
+    // Visit the serialized text of records [first, last) in order, walking frames from the first without further index lookups
+    template <class VISITOR> void forEachRecord(std::size_t first, std::size_t last, VISITOR&& visit) const {
+        if (first > last || last > size()) { throw std::out_of_range{ "Record log range out of range." }; }
+        if (first == last) { return; }
+        auto offset = OffsetOf(first);
+        for (auto i = first; i < last; ++i) {
+            const auto text = FrameAt(offset);
+            offset += record_log::lengthSize + text.size();
+            visit(text);
+        }
+    }
+
+    // Visit the deserialized records [first, last) in order
+    template <class VISITOR> void forEach(std::size_t first, std::size_t last, VISITOR&& visit) const {
+        forEachRecord(first, last, [&visit](std::string_view text) { visit(T::deserialize(text)); });
+    }
+
+private:
+    [[nodiscard]] std::uint64_t OffsetOf(std::size_t i) const {
+        return i < indexed_ ? record_log::IndexEntry(index_->bytes(), i) : unindexed_[i - indexed_];
+    }
+
+    // Text of the frame at 'offset'; a corrupt index entry may point anywhere, so the frame is bounds-checked
+    [[nodiscard]] std::string_view FrameAt(std::uint64_t offset) const {
+        const auto bytes = data_.bytes();
+        const auto end = record_log::FrameEnd(bytes, offset);
+        if (!end.has_value()) { throw std::runtime_error{ "Error reading record log: index entry does not point at a frame." }; }
+        return bytes.substr(static_cast<std::size_t>(offset + record_log::lengthSize), static_cast<std::size_t>(*end - offset - record_log::lengthSize));
+    }
+
+    record_log::MappedFile data_;
+    std::optional<record_log::MappedFile> index_{ };
+    std::size_t indexed_{ 0 }; // Leading records whose offsets are read from the mapped index
+    std::vector<std::uint64_t> unindexed_{ }; // Offsets of complete frames appended after the index was flushed
+};
+
+#endif // !SERIAL_RECORD_LOG_HPP
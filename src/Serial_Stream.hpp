@@ -0,0 +1,101 @@
+#ifndef SERIAL_STREAM_HPP
+#define SERIAL_STREAM_HPP 1
+
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include "Serial_CRTP.hpp"
+
+/// <summary>
+/// Incremental parser for a continuous stream of back-to-back serialized records arriving in arbitrary chunks.
+/// Brace depth is carried across chunk boundaries, so records (including nested objects) may be split anywhere.
+/// Each record is deserialized and handed to the callback as soon as its closing brace arrives.
+/// Records lying entirely within one chunk are deserialized straight from that chunk; only records split across chunks are copied.
+/// Views held by a deserialized object (e.g. std::string_view members) are only valid for the duration of the callback.
+/// A malformed record, or junk between records, is dropped without disturbing the records around it: the rest of the chunk is still parsed
+/// and emitted, then feed() rethrows the first error. An exception from the callback propagates at once, leaving the parser at a record boundary.
+/// </summary>
+template <class T, class CALLBACK>
+class StreamDeserializer {
+public:
+    explicit StreamDeserializer(CALLBACK callback) : callback_{ std::move(callback) } {}
+
+    // Consume the next chunk of input, emitting every record it completes; returns the number of records emitted
+    std::size_t feed(std::string_view chunk) {
+        auto emitted = std::size_t{ 0 };
+        auto failure = std::exception_ptr{ }; // First malformed record or junk of this chunk
+        auto recordBegin = std::size_t{ 0 }; // Start of the current record within this chunk
+        for (auto pos = std::size_t{ 0 }; pos < chunk.size(); ++pos) {
+            const auto c = chunk[pos];
+            if (depth_ == 0) {
+                if (c == '{') {
+                    depth_ = 1;
+                    recordBegin = pos;
+                }
+                else if (!IsWhitespace(c) && c != ' ' && c != '\r' && !failure) { // Junk is skipped up to the next record, like a malformed one
+                    failure = std::make_exception_ptr(std::runtime_error{ "Error parsing stream: unexpected character between records." });
+                }
+                continue;
+            }
+
+            if (c == '{') { ++depth_; }
+            else if (c == '}' && --depth_ == 0) {
+                const auto tail = chunk.substr(recordBegin, pos + 1 - recordBegin);
+                if (pending_.empty()) {
+                    emitted += emit(tail, failure); // Zero-copy: record lies entirely within this chunk
+                }
+                else {
+                    pending_.append(tail);
+                    try { emitted += emit(pending_, failure); }
+                    catch (...) {
+                        pending_.clear();
+                        throw;
+                    }
+                    pending_.clear(); // Keeps capacity for the next split record
+                }
+            }
+        }
+
+        // Carry over an unfinished record
+        if (depth_ > 0) { pending_.append(chunk.substr(recordBegin)); }
+        if (failure) { std::rethrow_exception(failure); }
+        return emitted;
+    }
+
+    // True when no partial record is buffered, i.e. the stream ended on a record boundary
+    [[nodiscard]] bool isIdle() const { return depth_ == 0; }
+
+    // Discard any partial record, e.g. after a connection reset
+    void reset() {
+        depth_ = 0;
+        pending_.clear();
+    }
+
+private:
+    // Hand one complete record to the callback; a malformed one is dropped and its error kept in 'failure'. Returns the number of records emitted.
+    std::size_t emit(std::string_view record, std::exception_ptr& failure) {
+        auto object = std::optional<T>{ };
+        try { object.emplace(T::deserialize(record)); }
+        catch (const std::runtime_error&) {
+            if (!failure) { failure = std::current_exception(); }
+            return 0;
+        }
+        callback_(std::move(*object));
+        return 1;
+    }
+
+    CALLBACK callback_;
+    std::string pending_{ };
+    std::size_t depth_{ 0 };
+};
+
+template <class T, class CALLBACK>
+StreamDeserializer<T, std::decay_t<CALLBACK>> MakeStreamDeserializer(CALLBACK&& callback) {
+    return StreamDeserializer<T, std::decay_t<CALLBACK>>{ std::forward<CALLBACK>(callback) };
+}
+
+#endif // !SERIAL_STREAM_HPP
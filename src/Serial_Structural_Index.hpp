@@ -0,0 +1,182 @@
+#ifndef SERIAL_STRUCTURAL_INDEX_HPP
+#define SERIAL_STRUCTURAL_INDEX_HPP 1
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define SERIAL_STRUCTURAL_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+/// <summary>
+/// Vectorized pre-pass over serialized text.
+/// Each 64-byte block is classified in one sweep into a bitmask of structural characters ('{', '}', '[', ']', ':', ',') and a bitmask of whitespace.
+/// The key/value splitter then walks set bits instead of inspecting every byte.
+/// The block classifier is chosen once at runtime: AVX2, SSE2, or a portable scalar fallback.
+/// </summary>
+namespace structural {
+
+inline constexpr std::size_t blockSize = 64;
+
+struct BlockMasks {
+    std::uint64_t structural{ 0 };
+    std::uint64_t whitespace{ 0 };
+};
+
+constexpr bool IsStructural(char c) {
+    return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+}
+
+constexpr bool IsWhitespaceChar(char c) {
+    return c == '\n' || c == '\t';
+}
+
+inline BlockMasks ScanBlockScalar(const char* block) {
+    auto masks = BlockMasks{ };
+    for (auto i = std::size_t{ 0 }; i < blockSize; ++i) {
+        masks.structural |= static_cast<std::uint64_t>(IsStructural(block[i])) << i;
+        masks.whitespace |= static_cast<std::uint64_t>(IsWhitespaceChar(block[i])) << i;
+    }
+    return masks;
+}
+
+#ifdef SERIAL_STRUCTURAL_X86
+inline BlockMasks ScanBlockSse2(const char* block) {
+    auto masks = BlockMasks{ };
+    for (auto i = std::size_t{ 0 }; i < blockSize; i += 16) {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+        const auto brackets = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('{')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('}'))),
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('[')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(']'))));
+        const auto structural = _mm_or_si128(brackets,
+            _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(':')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(','))));
+        const auto whitespace = _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\t')));
+        masks.structural |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(structural))) << i;
+        masks.whitespace |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(whitespace))) << i;
+    }
+    return masks;
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((target("avx2")))
+#endif
+inline BlockMasks ScanBlockAvx2(const char* block) {
+    auto masks = BlockMasks{ };
+    for (auto i = std::size_t{ 0 }; i < blockSize; i += 32) {
+        const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+        const auto brackets = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('{')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('}'))),
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('[')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(']'))));
+        const auto structural = _mm256_or_si256(brackets,
+            _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(':')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(','))));
+        const auto whitespace = _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\t')));
+        masks.structural |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(structural))) << i;
+        masks.whitespace |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(whitespace))) << i;
+    }
+    return masks;
+}
+
+inline bool CpuSupportsAvx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4]{ };
+    __cpuid(info, 1);
+    const auto osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+    __cpuidex(info, 7, 0);
+    return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif // SERIAL_STRUCTURAL_X86
+
+using ScanBlockFunction = BlockMasks(*)(const char*);
+
+inline ScanBlockFunction SelectScanBlock() {
+#ifdef SERIAL_STRUCTURAL_X86
+    return CpuSupportsAvx2() ? ScanBlockAvx2 : ScanBlockSse2;
+#else
+    return ScanBlockScalar;
+#endif
+}
+
+// Chosen once per process, on first use: a function-local static is initialized even when called from another translation unit's static initialization
+inline BlockMasks ScanBlock(const char* block) {
+    static const auto selected = SelectScanBlock();
+    return selected(block);
+}
+
+// Classify up to one block starting at 'offset'; bytes past the end of the input are never flagged
+inline BlockMasks ScanBlockAt(std::string_view input, std::size_t offset) {
+    const auto available = input.size() - offset;
+    if (available >= blockSize) { return ScanBlock(input.data() + offset); }
+
+    char padded[blockSize]{ };
+    std::memcpy(padded, input.data() + offset, available);
+    return ScanBlock(padded);
+}
+
+inline int CountTrailingZeros(std::uint64_t x) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index = 0;
+    _BitScanForward64(&index, x);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(x);
+#endif
+}
+
+/// <summary>
+/// Forward-only walk over the structural characters of a buffer, classifying one block at a time as it advances.
+/// Holds no storage beyond the current block, so it can be used per record without allocation.
+/// </summary>
+class StructuralCursor {
+public:
+    explicit StructuralCursor(std::string_view input) : input_{ input } {
+        if (!input_.empty()) { masks_ = ScanBlockAt(input_, 0); }
+    }
+
+    // Position of the next structural character at or after 'pos', or the input size if none remain
+    std::size_t nextStructural(std::size_t pos) {
+        for (;;) {
+            if (pos >= input_.size()) { return input_.size(); }
+            Seek(pos);
+            const auto remaining = masks_.structural & (~std::uint64_t{ 0 } << (pos - blockBegin_));
+            if (remaining != 0) { return blockBegin_ + static_cast<std::size_t>(CountTrailingZeros(remaining)); }
+            pos = blockBegin_ + blockSize;
+        }
+    }
+
+    // First non-whitespace position at or after 'pos', or the input size if none remain
+    std::size_t skipWhitespace(std::size_t pos) {
+        for (;;) {
+            if (pos >= input_.size()) { return input_.size(); }
+            Seek(pos);
+            const auto other = ~masks_.whitespace & (~std::uint64_t{ 0 } << (pos - blockBegin_));
+            if (other != 0) { return std::min(input_.size(), blockBegin_ + static_cast<std::size_t>(CountTrailingZeros(other))); }
+            pos = blockBegin_ + blockSize;
+        }
+    }
+
+private:
+    // Make the block containing 'pos' current; callers advance monotonically, so each block is classified once
+    void Seek(std::size_t pos) {
+        const auto blockBegin = pos - pos % blockSize;
+        if (blockBegin == blockBegin_) { return; }
+        blockBegin_ = blockBegin;
+        masks_ = ScanBlockAt(input_, blockBegin_);
+    }
+
+    std::string_view input_;
+    std::size_t blockBegin_{ 0 };
+    BlockMasks masks_{ };
+};
+
+} // namespace structural
+
+#endif // !SERIAL_STRUCTURAL_INDEX_HPP
@@ -2,8 +2,12 @@
 
 #include <array>
 #include <map>
+#include <memory>
 #include <optional>
 #include <set>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <vector>
 
 namespace serializable::traits {
@@ -27,6 +31,9 @@ template <typename... Args> inline constexpr bool isSet<std::set<Args...>> = tru
 template <typename T> inline constexpr bool isMap = false;
 template <typename... Args> inline constexpr bool isMap<std::map<Args...>> = true;
 
+template <typename T> inline constexpr bool isString = false;
+template <typename... Args> inline constexpr bool isString<std::basic_string<Args...>> = true;
+
 template <typename... Args>
 inline constexpr bool isContainer = isStdArray<Args...> || isVector<Args...> || isSet<Args...> || isMap<Args...>;
 
@@ -42,7 +49,63 @@ struct hasSerialization<
 > : std::true_type { };
 } // namespace hasSerializationImpl
 
+namespace hasSerializeIntoImpl {
+template <typename T, typename = void>
+struct hasSerializeInto : std::false_type { };
+template <typename T>
+struct hasSerializeInto<
+    T,
+    typename std::enable_if_t<std::is_invocable_v<decltype(&T::serializeInto), const T&, std::string&>>
+> : std::true_type { };
+} // namespace hasSerializeIntoImpl
+
 template <class T>
 inline constexpr bool hasSerializationInterface{ hasSerializationImpl::hasSerialization<std::decay_t<T>>::value };
 
+namespace hasMemberMappingImpl {
+template <typename T, typename = void>
+struct hasMemberMapping : std::false_type { };
+template <typename T>
+struct hasMemberMapping<T, std::void_t<decltype(T::DefineMemberMapping())>> : std::true_type { };
+} // namespace hasMemberMappingImpl
+
+namespace hasSerializedSizeImpl {
+template <typename T, typename = void>
+struct hasSerializedSize : std::false_type { };
+template <typename T>
+struct hasSerializedSize<
+    T,
+    typename std::enable_if_t<std::is_invocable_r_v<std::size_t, decltype(&T::serializedSize), const T&>>
+> : std::true_type { };
+} // namespace hasSerializedSizeImpl
+
+// Types which declare member <-> name bindings through DefineMemberMapping()
+template <class T>
+inline constexpr bool hasMemberMapping{ hasMemberMappingImpl::hasMemberMapping<std::decay_t<T>>::value };
+
+// Serializable types which can report their exact serialized length up front
+template <class T>
+inline constexpr bool hasSerializedSizeInterface{ hasSerializationInterface<T> && hasSerializedSizeImpl::hasSerializedSize<std::decay_t<T>>::value };
+
+// Serializable types which can also append into a caller-supplied buffer
+template <class T>
+inline constexpr bool hasSerializeIntoInterface{ hasSerializationInterface<T> && hasSerializeIntoImpl::hasSerializeInto<std::decay_t<T>>::value };
+
+// Unqualified spelling of T as the compiler prints it, e.g. "FOO"
+template <class T> constexpr std::string_view TypeName() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    constexpr auto signature = std::string_view{ __FUNCSIG__ }; // "... TypeName<struct FOO>(void)"
+    constexpr auto begin = signature.find("TypeName<") + 9;
+    auto name = signature.substr(begin, signature.rfind(">(void)") - begin);
+    for (auto prefix : { std::string_view{ "struct " }, std::string_view{ "class " }, std::string_view{ "enum " } }) {
+        if (name.substr(0, prefix.size()) == prefix) { name.remove_prefix(prefix.size()); }
+    }
+    return name;
+#else
+    constexpr auto signature = std::string_view{ __PRETTY_FUNCTION__ }; // "... TypeName() [with T = FOO; ...]" or "... [T = FOO]"
+    constexpr auto begin = signature.find("T = ") + 4;
+    return signature.substr(begin, signature.find_first_of(";]", begin) - begin);
+#endif
+}
+
 } // namespace serializable::traits
\ No newline at end of file
@@ -0,0 +1,131 @@
+#ifndef SERIAL_VIEW_HPP
+#define SERIAL_VIEW_HPP 1
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include "Serial_CRTP.hpp"
+
+namespace view_detail {
+
+template <class M, class C> M MemberTypeOf(M C::*);
+
+// Type of the member a pointer to member refers to
+template <auto MEMBER>
+using MemberType = decltype(MemberTypeOf(MEMBER));
+
+// Mapping index of the binding for MEMBER, or the mapping size when MEMBER is not mapped
+template <class T, auto MEMBER> constexpr std::size_t BindingIndex() {
+    constexpr auto mapping = T::DefineMemberMapping();
+    auto index = std::tuple_size_v<decltype(mapping)>;
+    auto counter = std::size_t{ 0 };
+    auto Match = [&index, &counter](const auto &...binding) {
+        auto MatchOne = [&index, &counter](const auto& element) {
+            if constexpr (std::is_same_v<decltype(element.member_), decltype(MEMBER)>) {
+                if (element.member_ == MEMBER) { index = counter; }
+            }
+            ++counter;
+        };
+        (MatchOne(binding), ...);
+    };
+    std::apply(Match, mapping);
+    return index;
+}
+
+} // namespace view_detail
+
+/// <summary>
+/// Read-only view over one serialized object that decodes fields on demand.
+/// The key/value positions are indexed lazily: a lookup scans forward only until the requested key, recording every key it passes,
+/// so fields near the front of a record cost little to reach and no position is scanned twice.
+/// get<&T::member_>() decodes just that field, and nested mapped objects can be viewed in turn without being decoded.
+/// Lookups extend the index, so they are non-const. Suits consumers that inspect one or two fields and drop most records. The view and everything it returns refer into 'text'.
+/// A key repeated within one object resolves to its first occurrence, whatever the order of lookups; deserialize() keeps the last one instead,
+/// which would require scanning the whole body before answering.
+/// </summary>
+template <class T>
+class SerializedView {
+public:
+    constexpr explicit SerializedView(std::string_view text) : body_{ TrimWhitespace(text) } {
+        if (body_.size() < 2 || body_.front() != '{' || body_.back() != '}') { throw std::runtime_error{ "Error parsing view: expected an object." }; }
+        body_ = body_.substr(1, body_.size() - 2);
+    }
+
+    // Serialized text of a field; empty when the field is null or absent
+    template <auto MEMBER> [[nodiscard]] constexpr std::string_view raw() {
+        constexpr auto index = IndexOf<MEMBER>();
+        while (!seen_[index] && next_ < body_.size()) { IndexNext(); }
+        return values_[index];
+    }
+
+    // Whether a field holds a value, i.e. is neither null nor absent
+    template <auto MEMBER> [[nodiscard]] constexpr bool has() {
+        return !raw<MEMBER>().empty();
+    }
+
+    // Decode a single field exactly as deserialize() would, keys repeated within the object aside
+    template <auto MEMBER> [[nodiscard]] constexpr view_detail::MemberType<MEMBER> get() {
+        return deserializeInternal<view_detail::MemberType<MEMBER>>(raw<MEMBER>());
+    }
+
+    // View a nested mapped object without decoding it; std::nullopt for an empty optional
+    template <auto MEMBER> [[nodiscard]] constexpr auto view() {
+        using namespace serializable::traits;
+        using MEMBER_TYPE = view_detail::MemberType<MEMBER>;
+
+        if constexpr (isOptional<MEMBER_TYPE>) {
+            static_assert(hasMemberMapping<typename MEMBER_TYPE::value_type>, "Only mapped members can be viewed");
+            using VIEW = SerializedView<typename MEMBER_TYPE::value_type>;
+            return has<MEMBER>() ? std::optional<VIEW>{ VIEW{ raw<MEMBER>() } } : std::optional<VIEW>{ };
+        }
+        else {
+            static_assert(hasMemberMapping<MEMBER_TYPE>, "Only mapped members can be viewed");
+            return SerializedView<MEMBER_TYPE>{ raw<MEMBER>() };
+        }
+    }
+
+private:
+    template <auto MEMBER> static constexpr std::size_t IndexOf() {
+        constexpr auto index = view_detail::BindingIndex<T, MEMBER>();
+        static_assert(index < size, "Member is not part of the mapping");
+        return index;
+    }
+
+    // Record the next key/value pair, as ForEachKeyValue() would split it
+    constexpr void IndexNext() {
+        const auto scanner = ScalarScanner{ body_ };
+        const auto keyBeginPos = scanner.skipWhitespace(next_);
+        const auto colonPos = scanner.findColon(keyBeginPos);
+        if (colonPos >= body_.size()) { // Only whitespace remains
+            next_ = body_.size();
+            return;
+        }
+        const auto valueBeginPos = colonPos + 2; // Advance past ':' and ' '
+        const auto endPos = scanner.findValueEnd(valueBeginPos);
+        next_ = endPos + 1;
+
+        const auto index = keyIndex<T>.find(body_.substr(keyBeginPos, colonPos - keyBeginPos - 1));
+        if (index == keyIndex<T>.npos) { // Unrecognized keys are discarded
+            instrumentation::CountUnknownKey<T>();
+            return;
+        }
+        if (seen_[index]) { return; } // First occurrence wins
+        auto value = body_.substr(std::min(valueBeginPos, body_.size()), endPos - std::min(valueBeginPos, endPos));
+        while (!value.empty() && IsWhitespace(value.back())) { value.remove_suffix(1); } // Trim trailing whitespace
+        values_[index] = value;
+        seen_[index] = true;
+    }
+
+    static constexpr std::size_t size = std::tuple_size_v<decltype(T::DefineMemberMapping())>;
+
+    std::string_view body_; // Braces removed
+    std::size_t next_{ 0 }; // Index filled in as lookups advance through the body
+    std::array<std::string_view, size> values_{ }; // Indexed the same as the mapping
+    std::array<bool, size> seen_{ };
+};
+
+#endif // !SERIAL_VIEW_HPP
@@ -1,8 +1,10 @@
 #ifndef LIMITED_CONSTEXPR_UTILITIES_HPP
 #define LIMITED_CONSTEXPR_UTILITIES_HPP 1
 
-#include <optional>
-#include <type_traits>
+#include <array>
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
 
 /// <summary>
 /// A series of limited utilities meant to provide "good enough" constexpr capabilities to perform constexpr unit tests.
@@ -10,33 +12,67 @@
 /// </summary>
 namespace limited_constexpr {
 
-// C-string to integral with minor checking. Overflow may occur.
-template<class INTEGRAL>
-constexpr std::optional<INTEGRAL> FromChars(const char* begin, const char* end) {
-	auto result = INTEGRAL{};
-	if (end <= begin) { return std::nullopt; }
+// Substitute for C++20 std::is_constant_evaluated(); compilers lacking the builtin always take the constexpr-safe path
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define LIMITED_CONSTEXPR_HAS_IS_CONSTANT_EVALUATED 1
+#endif
+#endif
+#if !defined(LIMITED_CONSTEXPR_HAS_IS_CONSTANT_EVALUATED) && ((defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+#define LIMITED_CONSTEXPR_HAS_IS_CONSTANT_EVALUATED 1
+#endif
 
-	constexpr auto base = 10; // Start by building base 10
+constexpr bool IsConstantEvaluated() {
+#ifdef LIMITED_CONSTEXPR_HAS_IS_CONSTANT_EVALUATED
+	return __builtin_is_constant_evaluated();
+#else
+	return true;
+#endif
+}
+
+// Fixed-capacity string usable in constant expressions, standing in for C++20 constexpr std::string
+template<std::size_t CAPACITY>
+class FixedString {
+public:
+	constexpr FixedString() = default;
 
-	bool isNegative = false;
+	[[nodiscard]] constexpr std::size_t size() const { return size_; }
+	[[nodiscard]] static constexpr std::size_t capacity() { return CAPACITY; }
+	[[nodiscard]] constexpr bool empty() const { return size_ == 0; }
+	[[nodiscard]] constexpr const char* data() const { return data_.data(); }
+	[[nodiscard]] constexpr const char* begin() const { return data_.data(); }
+	[[nodiscard]] constexpr const char* end() const { return data_.data() + size_; }
+	[[nodiscard]] constexpr char operator[](std::size_t pos) const { return data_[pos]; }
+	[[nodiscard]] constexpr std::string_view view() const { return { data_.data(), size_ }; }
+	constexpr operator std::string_view() const { return view(); }
 
-	if constexpr (std::is_signed_v<INTEGRAL>) {
-		if (*begin == '-') {
-			isNegative = true;
-			++begin;
-		}
+	constexpr void push_back(char c) {
+		RequireRoom(1);
+		data_[size_++] = c;
 	}
 
-	while (begin < end) {
-		if (*begin < '0' || *begin > '9') {
-			return std::nullopt;
-		}
-		result = result * base + (*begin - '0');
-		++begin;
+	constexpr void append(std::string_view sv) {
+		RequireRoom(sv.size());
+		for (auto c : sv) { data_[size_++] = c; }
 	}
 
-	return isNegative ? -1 * result : result;
-}
+	// Shrink, or grow padding with '\0'
+	constexpr void resize(std::size_t size) {
+		if (size > CAPACITY) { throw std::length_error{ "FixedString capacity exceeded." }; }
+		for (auto i = size_; i < size; ++i) { data_[i] = '\0'; }
+		size_ = size;
+	}
+
+	constexpr void clear() { size_ = 0; }
+
+private:
+	constexpr void RequireRoom(std::size_t count) const {
+		if (count > CAPACITY - size_) { throw std::length_error{ "FixedString capacity exceeded." }; }
+	}
+
+	std::array<char, CAPACITY> data_{ };
+	std::size_t size_{ 0 };
+};
 
 }
 
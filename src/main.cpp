@@ -3,6 +3,6 @@
 int main() {
     /// Example of compile-time definition & usage of member <-> name mapping
     static constexpr auto myVar = FOO{ 1, "abc", '-' };
-    std::cout << myVar.serialize() << std::endl;
+    std::cout << serializedConstant<myVar> << std::endl; // Serialized during compilation
     return 0;
 }
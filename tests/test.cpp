@@ -1,5 +1,19 @@
 #include "Foo.hpp"
+#include "Serial_Batch.hpp"
+#include "Serial_Binary_CRTP.hpp"
+#include "Serial_Checked.hpp"
+#include "Serial_Columnar.hpp"
+#include "Serial_Delta.hpp"
+#include "Serial_Instrumentation.hpp"
+#include "Serial_Record_Log.hpp"
+#include "Serial_Stream.hpp"
+#include "Serial_View.hpp"
 #include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <new>
+#include <unordered_set>
 
 TEST_CASE("Constexpr (in)equality") {
     static constexpr auto myVar = FOO{ 1, "abc", '-' };
@@ -213,3 +227,1396 @@ TEST_CASE("Recursive Serialization of Fundamental Types Mixed with Complex Types
 
     CHECK(myVar.serialize() == serializationOutput.data());
 }
+
+TEST_CASE("Serialization appends into a caller-supplied buffer") {
+    static constexpr auto myFoo = FOO{ 1, "abc", '-' };
+    static constexpr auto myBar = BAR{ 1, "abc", "Extra notes" };
+
+    // Output is appended, so several records may share one buffer
+    auto buffer = std::string{ "prefix:" };
+    myFoo.serializeInto(buffer);
+    myBar.serializeInto(buffer);
+    CHECK(buffer == "prefix:{\n\tone : 1,\n\ttwo : abc,\n\tthree : -\n}{\n\tone : 1,\n\ttwo : abc\n}");
+
+    // Nested and optional members are written straight into the same buffer
+    auto nested = std::string{ };
+    FOO_OPTIONAL_BAR{ myFoo, myBar }.serializeInto(nested);
+    CHECK(nested == FOO_BAR{ myFoo, myBar }.serialize());
+
+    // Null values are omitted along with their key, including when they are the final field
+    auto omitted = std::string{ };
+    FOO_STRING_VIEW{ myFoo, "" }.serializeInto(omitted);
+    CHECK(omitted == "{\n\tfoo : {\n\tone : 1,\n\ttwo : abc,\n\tthree : -\n}\n}");
+    CHECK(BAZ{ }.serialize() == "{\n}");
+}
+
+struct FIXED_WIDTH : public SERIALIZATION<FIXED_WIDTH>, LEXICOGRAPHICAL_EQUALITY<FIXED_WIDTH> {
+    int number_{ 0 };
+    char letter_{ 'a' };
+    std::optional<int> maybe_{};
+
+    constexpr FIXED_WIDTH() = default;
+
+    constexpr FIXED_WIDTH(int number, char letter, std::optional<int> maybe) : number_{ number }, letter_{ letter }, maybe_{ maybe } { }
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&FIXED_WIDTH::number_, "number"), MakeBinding(&FIXED_WIDTH::letter_, "letter"), MakeBinding(&FIXED_WIDTH::maybe_, "maybe"));
+    }
+};
+
+TEST_CASE("Serialized size is computed exactly ahead of serialization") {
+    static constexpr auto myFoo = FOO{ 1, "abc", '-' };
+    static constexpr auto myBar = BAR{ -42, "abc", "Extra notes" };
+
+    // Fields are sized at compile time, including integer digit counts
+    STATIC_REQUIRE(myFoo.serializedSize() == std::string_view{ "{\n\tone : 1,\n\ttwo : abc,\n\tthree : -\n}" }.size());
+    STATIC_REQUIRE(myBar.serializedSize() == std::string_view{ "{\n\tone : -42,\n\ttwo : abc\n}" }.size());
+    STATIC_REQUIRE(BAZ{ }.serializedSize() == std::string_view{ "{\n}" }.size());
+
+    // Nested objects and omitted empty optionals
+    CHECK(FOO_BAR{ myFoo, myBar }.serializedSize() == FOO_BAR{ myFoo, myBar }.serialize().size());
+    CHECK(FOO_OPTIONAL_BAR{ myFoo, std::nullopt }.serializedSize() == FOO_OPTIONAL_BAR{ myFoo, std::nullopt }.serialize().size());
+    CHECK(FOO_STRING_VIEW{ myFoo, "" }.serializedSize() == FOO_STRING_VIEW{ myFoo, "" }.serialize().size());
+
+    // Frames for a batch may be pre-sized from the individual records
+    auto frame = std::string{ };
+    frame.reserve(myFoo.serializedSize() + myBar.serializedSize());
+    myFoo.serializeInto(frame);
+    myBar.serializeInto(frame);
+    CHECK(frame.size() == myFoo.serializedSize() + myBar.serializedSize());
+}
+
+TEST_CASE("Fixed-width types expose a compile-time serialized size bound") {
+    static constexpr auto smallest = FIXED_WIDTH{ 0, 'x', std::nullopt };
+    static constexpr auto largest = FIXED_WIDTH{ std::numeric_limits<int>::min(), ',', std::numeric_limits<int>::min() }; // The letter is escaped
+
+    STATIC_REQUIRE(smallest.serializedSize() < FIXED_WIDTH::maxSerializedSize());
+    STATIC_REQUIRE(largest.serializedSize() == FIXED_WIDTH::maxSerializedSize());
+    CHECK(largest.serialize().size() == FIXED_WIDTH::maxSerializedSize());
+
+    // Buffers may be sized at compile time
+    auto buffer = std::array<char, FIXED_WIDTH::maxSerializedSize()>{ };
+    CHECK(buffer.size() == largest.serializedSize());
+}
+
+TEST_CASE("Compile-time key index maps binding names to mapping order") {
+    STATIC_REQUIRE(keyIndex<FOO>.find("one") == 0);
+    STATIC_REQUIRE(keyIndex<FOO>.find("two") == 1);
+    STATIC_REQUIRE(keyIndex<FOO>.find("three") == 2);
+    STATIC_REQUIRE(keyIndex<FOO>.find("four") == keyIndex<FOO>.npos);
+    STATIC_REQUIRE(keyIndex<FOO>.find("") == keyIndex<FOO>.npos);
+    STATIC_REQUIRE(keyIndex<BAZ>.find("c") == keyIndex<BAZ>.npos);
+
+    // Every name in a wider table resolves to its own index; first occurrence of a duplicate name wins
+    static constexpr auto names = std::array<std::string_view, 28>{
+        "alpha", "bravo", "charlie", "delta", "echo", "foxtrot", "golf", "hotel", "india", "juliett",
+        "kilo", "lima", "mike", "november", "oscar", "papa", "quebec", "romeo", "sierra", "tango",
+        "uniform", "victor", "whiskey", "xray", "yankee", "zulu", "alpha", "alph" };
+    static constexpr auto index = KEY_INDEX<names.size()>{ names };
+    for (auto i = std::size_t{ 0 }; i < 26; ++i) {
+        CHECK(index.find(names[i]) == i);
+    }
+    STATIC_REQUIRE(index.find("alpha") == 0);
+    STATIC_REQUIRE(index.find("alph") == 27);
+    STATIC_REQUIRE(index.find("zulu!") == index.npos);
+
+    // Unrecognized keys are still skipped during deserialization
+    static constexpr auto input = std::string_view{ "{\n\tfour : 4,\n\tone : -42,\n\ttwo : abc\n}" };
+    STATIC_CHECK(BAR::deserialize(input) == BAR{ -42, "abc", "" });
+}
+
+enum class COLOR : short { RED = 1, GREEN = 2, BLUE = -3 };
+
+// Every mapped member is fixed-width: layout is known at compile time
+struct PACKET : public BINARY_SERIALIZATION<PACKET>, LEXICOGRAPHICAL_EQUALITY<PACKET> {
+    int id_{ 0 };
+    char tag_{ ' ' };
+    COLOR color_{ COLOR::RED };
+    double weight_{ 0.0 };
+
+    PACKET() = default;
+
+    constexpr PACKET(int id, char tag, COLOR color, double weight) : id_{ id }, tag_{ tag }, color_{ color }, weight_{ weight } { }
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&PACKET::id_, "id"), MakeBinding(&PACKET::tag_, "tag"), MakeBinding(&PACKET::color_, "color"), MakeBinding(&PACKET::weight_, "weight"));
+    }
+};
+
+struct ENVELOPE : public BINARY_SERIALIZATION<ENVELOPE>, LEXICOGRAPHICAL_EQUALITY<ENVELOPE> {
+    std::string_view name_{};
+    std::optional<int> priority_{};
+    PACKET packet_{};
+    std::optional<FOO> foo_{};
+
+    ENVELOPE() = default;
+
+    ENVELOPE(std::string_view name, std::optional<int> priority, PACKET packet, std::optional<FOO> foo) : name_{ name }, priority_{ priority }, packet_{ packet }, foo_{ foo } { }
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&ENVELOPE::name_, "name"), MakeBinding(&ENVELOPE::priority_, "priority"), MakeBinding(&ENVELOPE::packet_, "packet"), MakeBinding(&ENVELOPE::foo_, "foo"));
+    }
+};
+
+TEST_CASE("Binary encoding of fixed-width types uses a compile-time layout") {
+    STATIC_REQUIRE(binary::isFixedWidth<PACKET>);
+    STATIC_REQUIRE(binary::fixedSize<PACKET> == sizeof(int) + sizeof(char) + sizeof(short) + sizeof(double));
+    STATIC_REQUIRE_FALSE(binary::isFixedWidth<ENVELOPE>);
+
+    static constexpr auto myPacket = PACKET{ 0x01020304, 'x', COLOR::BLUE, 1.5 };
+    const auto encoded = myPacket.serializeBinary();
+    REQUIRE(encoded.size() == binary::fixedSize<PACKET>);
+    CHECK(encoded.substr(0, 5) == std::string{ "\x04\x03\x02\x01x", 5 }); // Little-endian scalars, no names or separators
+    CHECK(PACKET::deserializeBinary(encoded) == myPacket);
+
+    CHECK_THROWS_AS(PACKET::deserializeBinary(std::string_view{ encoded }.substr(1)), std::runtime_error);
+    CHECK_THROWS_AS(PACKET::deserializeBinary(encoded + '!'), std::runtime_error);
+}
+
+TEST_CASE("Binary encoding round-trips strings, optionals and nested objects") {
+    static constexpr auto myPacket = PACKET{ -7, 'q', COLOR::GREEN, -0.25 };
+    static constexpr auto myFoo = FOO{ 1, "abc", '-' };
+
+    const auto full = ENVELOPE{ "envelope", 3, myPacket, myFoo };
+    const auto encodedFull = full.serializeBinary();
+    CHECK(encodedFull.size() == full.binarySize());
+    CHECK(ENVELOPE::deserializeBinary(encodedFull) == full);
+
+    // Absent optionals cost one presence bit and no payload
+    const auto sparse = ENVELOPE{ "", std::nullopt, myPacket, std::nullopt };
+    const auto encodedSparse = sparse.serializeBinary();
+    CHECK(encodedSparse.size() == 1 + sizeof(binary::LengthPrefix) + binary::fixedSize<PACKET>);
+    CHECK(ENVELOPE::deserializeBinary(encodedSparse) == sparse);
+
+    // Lengths past the 32-bit prefix are rejected while sizing, before any byte is written
+    CHECK(binary::CheckedLength(0xFFFFFFFF) == 0xFFFFFFFF);
+    if constexpr (sizeof(std::size_t) > sizeof(binary::LengthPrefix)) {
+        CHECK_THROWS_AS(binary::CheckedLength(std::size_t{ 0xFFFFFFFF } + 1), std::length_error);
+    }
+
+    // Records may be appended back to back and decoded one at a time
+    auto stream = std::string{ };
+    full.serializeBinaryInto(stream);
+    sparse.serializeBinaryInto(stream);
+    auto remaining = std::string_view{ stream };
+    CHECK(DeserializeBinaryFromMetadata<ENVELOPE>(remaining) == full);
+    CHECK(DeserializeBinaryFromMetadata<ENVELOPE>(remaining) == sparse);
+    CHECK(remaining.empty());
+
+    for (auto length = std::size_t{ 0 }; length < encodedFull.size(); ++length) {
+        CHECK_THROWS_AS(ENVELOPE::deserializeBinary(std::string_view{ encodedFull }.substr(0, length)), std::runtime_error);
+    }
+}
+
+TEST_CASE("Recursive Deserialization of Nested and Optional Serializable Objects") {
+    static constexpr auto myFoo = FOO{ 1, "abc", '-' };
+    static constexpr auto myBar = BAR{ -42, "ab", "" };
+
+    static constexpr auto nested = FOO_BAR{ myFoo, myBar };
+    CHECK(FOO_BAR::deserialize(nested.serialize()) == nested);
+
+    // Present & omitted optionals
+    CHECK(FOO_OPTIONAL_BAR::deserialize(FOO_OPTIONAL_BAR{ myFoo, myBar }.serialize()) == FOO_OPTIONAL_BAR{ myFoo, myBar });
+    CHECK(FOO_OPTIONAL_BAR::deserialize(FOO_OPTIONAL_BAR{ myFoo, std::nullopt }.serialize()) == FOO_OPTIONAL_BAR{ myFoo, std::nullopt });
+
+    // Nested objects are constexpr capable as well
+    static constexpr auto input = std::string_view{ "{\n\tbar : {\n\tone : 7,\n\ttwo : xyz\n},\n\tfoo : {\n\tone : 1,\n\ttwo : abc,\n\tthree : -\n}\n}" };
+    STATIC_CHECK(FOO_BAR::deserialize(input) == FOO_BAR{ myFoo, BAR{ 7, "xyz", "" } });
+}
+
+TEST_CASE("Streaming deserialization across arbitrary chunk boundaries") {
+    const auto records = std::array<FOO_OPTIONAL_BAR, 3>{
+        FOO_OPTIONAL_BAR{ FOO{ 1, "abc", '-' }, BAR{ 2, "def", "" } },
+        FOO_OPTIONAL_BAR{ FOO{ 3, "ghi", '+' }, std::nullopt },
+        FOO_OPTIONAL_BAR{ FOO{ -4, "jkl", '*' }, BAR{ 5, "mno", "" } } };
+
+    // Back-to-back records, with or without whitespace between them
+    const auto stream = records[0].serialize() + "\n" + records[1].serialize() + records[2].serialize() + "\n";
+
+    // Split the stream in every possible place, including inside nested objects
+    for (auto split = std::size_t{ 0 }; split <= stream.size(); ++split) {
+        auto received = std::size_t{ 0 };
+        auto matches = true;
+        auto parser = MakeStreamDeserializer<FOO_OPTIONAL_BAR>([&received, &matches, &records](const FOO_OPTIONAL_BAR& record) {
+            matches = matches && received < records.size() && record == records[received];
+            ++received;
+        });
+        const auto emitted = parser.feed(std::string_view{ stream }.substr(0, split)) + parser.feed(std::string_view{ stream }.substr(split));
+        CHECK(emitted == records.size());
+        CHECK(received == records.size());
+        CHECK(matches);
+        CHECK(parser.isIdle());
+    }
+
+    // Byte-at-a-time delivery
+    auto received = std::size_t{ 0 };
+    auto parser = MakeStreamDeserializer<FOO_OPTIONAL_BAR>([&received, &records](const FOO_OPTIONAL_BAR& record) {
+        CHECK(record == records[received++]);
+    });
+    for (auto c : stream) { parser.feed(std::string_view{ &c, 1 }); }
+    CHECK(received == records.size());
+
+    // Partial records are held until completed or reset
+    parser.feed("{\n\tfoo : {");
+    CHECK_FALSE(parser.isIdle());
+    parser.reset();
+    CHECK(parser.isIdle());
+    CHECK_THROWS_AS(parser.feed("garbage"), std::runtime_error);
+
+    // A malformed record split across chunks is dropped; the records after it still arrive, and no stale bytes reach the next chunk
+    auto expected = std::size_t{ 1 };
+    auto recovering = MakeStreamDeserializer<FOO_OPTIONAL_BAR>([&expected, &records](const FOO_OPTIONAL_BAR& record) {
+        CHECK(record == records[expected++]);
+    });
+    const auto bad = std::string{ "{\n\tfoo : {\n\tone : oops\n}\n}" };
+    CHECK(recovering.feed(std::string_view{ bad }.substr(0, 5)) == 0);
+    const auto rest = std::string{ bad.substr(5) } + "\n" + records[1].serialize();
+    CHECK_THROWS_AS(recovering.feed(rest), std::runtime_error);
+    CHECK(expected == 2);
+    CHECK(recovering.isIdle());
+    const auto next = records[2].serialize();
+    CHECK(recovering.feed(next) == 1);
+    CHECK(expected == 3);
+
+    // Junk between records is skipped up to the next record, keeping the records after it
+    expected = 0;
+    const auto junk = "oops " + records[0].serialize() + "\n}} " + records[1].serialize() + " " + bad;
+    CHECK_THROWS_WITH(recovering.feed(junk), "Error parsing stream: unexpected character between records."); // The first error, not the malformed record after it
+    CHECK(expected == 2);
+    CHECK(recovering.isIdle());
+}
+
+TEST_CASE("Vectorized structural scanning matches the scalar scanner") {
+    // Every block classifier agrees with the portable one
+    auto text = std::string{ };
+    for (auto i = 0; i < 4 * static_cast<int>(structural::blockSize); ++i) { text.push_back("{a}: ,\n\tb-"[i * 7 % 11]); }
+    for (auto offset = std::size_t{ 0 }; offset + structural::blockSize <= text.size(); offset += 13) {
+        const auto expected = structural::ScanBlockScalar(text.data() + offset);
+        const auto actual = structural::ScanBlock(text.data() + offset);
+        CHECK(actual.structural == expected.structural);
+        CHECK(actual.whitespace == expected.whitespace);
+    }
+
+    // Key/value splitting agrees on records spanning several blocks, with nested objects and uneven whitespace
+    const auto long_text = std::string(150, 'x');
+    const auto records = std::array<std::string, 4>{
+        FOO_STRING_VIEW{ FOO{ 1, long_text, '-' }, long_text }.serialize(),
+        FOO_BAR{ FOO{ 12345, "abc", ':' }, BAR{ -1, long_text, "" } }.serialize(),
+        std::string{ "{two : abc,\nthree : -,\tone : 1}" },
+        std::string{ "{\n\t\t\n}" } };
+    for (const auto& record : records) {
+        const auto body = std::string_view{ record }.substr(1, record.size() - 2);
+        auto scalar = std::vector<std::pair<std::string_view, std::string_view>>{ };
+        auto indexed = std::vector<std::pair<std::string_view, std::string_view>>{ };
+        ForEachKeyValue(body, ScalarScanner{ body }, [&scalar](std::string_view key, std::string_view value) { scalar.emplace_back(key, value); });
+        ForEachKeyValueIndexed(body, [&indexed](std::string_view key, std::string_view value) { indexed.emplace_back(key, value); });
+        CHECK(indexed == scalar);
+    }
+
+    CHECK(FOO_BAR::deserialize(records[1]) == FOO_BAR{ FOO{ 12345, "abc", ':' }, BAR{ -1, long_text, "" } });
+}
+
+struct INVENTORY : public SERIALIZATION<INVENTORY>, BINARY_SERIALIZATION<INVENTORY>, LEXICOGRAPHICAL_EQUALITY<INVENTORY> {
+    std::vector<FOO> items_{};
+    std::array<int, 3> dimensions_{};
+    std::set<char> tags_{};
+    std::map<std::string_view, int> counts_{};
+    std::vector<std::vector<int>> grid_{};
+
+    INVENTORY() = default;
+
+    INVENTORY(std::vector<FOO> items, std::array<int, 3> dimensions, std::set<char> tags, std::map<std::string_view, int> counts, std::vector<std::vector<int>> grid)
+        : items_{ std::move(items) }, dimensions_{ dimensions }, tags_{ std::move(tags) }, counts_{ std::move(counts) }, grid_{ std::move(grid) } { }
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&INVENTORY::items_, "items"), MakeBinding(&INVENTORY::dimensions_, "dimensions"), MakeBinding(&INVENTORY::tags_, "tags"),
+            MakeBinding(&INVENTORY::counts_, "counts"), MakeBinding(&INVENTORY::grid_, "grid"));
+    }
+};
+
+struct BOX : public SERIALIZATION<BOX>, LEXICOGRAPHICAL_EQUALITY<BOX> {
+    std::array<int, 3> dimensions_{};
+    char label_{ ' ' };
+
+    constexpr BOX() = default;
+
+    constexpr BOX(std::array<int, 3> dimensions, char label) : dimensions_{ dimensions }, label_{ label } { }
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&BOX::dimensions_, "dimensions"), MakeBinding(&BOX::label_, "label"));
+    }
+};
+
+TEST_CASE("Containers serialize with a leading element count") {
+    auto output = std::string{ };
+    serializeInternal(output, std::vector<int>{ 1, -2, 3 });
+    CHECK(output == "[3 : 1, -2, 3]");
+    output.clear();
+    serializeInternal(output, std::map<std::string_view, int>{ { "a", 1 }, { "b", 2 } });
+    CHECK(output == "[2 : a : 1, b : 2]");
+    output.clear();
+    serializeInternal(output, std::set<char>{ });
+    CHECK(output == "[0]");
+
+    const auto myVar = INVENTORY{ { FOO{ 1, "abc", '-' }, FOO{ 2, "def", '+' } }, { 4, 5, 6 }, { 'x', 'y' }, { { "apples", 3 }, { "pears", 0 } }, { { 1, 2 }, { }, { 3 } } };
+    const auto text = myVar.serialize();
+    CHECK(text.size() == myVar.serializedSize());
+    CHECK(INVENTORY::deserialize(text) == myVar);
+    CHECK(INVENTORY::deserialize(INVENTORY{ }.serialize()) == INVENTORY{ });
+
+    const auto encoded = myVar.serializeBinary();
+    CHECK(encoded.size() == myVar.binarySize());
+    CHECK(INVENTORY::deserializeBinary(encoded) == myVar);
+    STATIC_REQUIRE(binary::isFixedWidth<std::array<int, 3>>);
+
+    // Element counts must agree with the elements present
+    CHECK_THROWS_AS(deserializeInternal<std::vector<int>>("[3 : 1, 2]"), std::runtime_error);
+    CHECK_THROWS_AS(deserializeInternal<std::vector<int>>("[1 : 1, 2]"), std::runtime_error);
+    CHECK_THROWS_AS((deserializeInternal<std::array<int, 3>>("[2 : 1, 2]")), std::runtime_error);
+
+    // std::array is filled in place, in constant expressions as well
+    static constexpr auto myBox = BOX{ { 1, 22, -333 }, 'b' };
+    static constexpr auto boxText = std::string_view{ "{\n\tdimensions : [3 : 1, 22, -333],\n\tlabel : b\n}" };
+    CHECK(myBox.serialize() == boxText);
+    CHECK(BOX::deserialize(boxText) == myBox);
+    static constexpr auto boxConstexpr = BOX::deserialize(boxText); // std::array comparison is not constexpr until C++20
+    STATIC_CHECK(boxConstexpr.dimensions_[0] == 1);
+    STATIC_CHECK(boxConstexpr.dimensions_[2] == -333);
+    STATIC_CHECK(boxConstexpr.label_ == 'b');
+    STATIC_CHECK(BOX::maxSerializedSize() >= myBox.serializedSize());
+}
+
+TEST_CASE("Work-stealing pool runs every index exactly once") {
+    auto pool = WorkStealingPool{ 4 };
+    REQUIRE(pool.threadCount() == 4);
+
+    auto hits = std::vector<int>(1000);
+    pool.parallelFor(hits.size(), [&hits](std::size_t index) { hits[index] += 1; });
+    CHECK(std::all_of(hits.begin(), hits.end(), [](int hit) { return hit == 1; }));
+
+    // Exceptions reach the caller once all other indices have run, and the pool remains usable
+    auto completed = std::vector<int>(64);
+    CHECK_THROWS_AS(pool.parallelFor(completed.size(), [&completed](std::size_t index) {
+        if (index == 17) { throw std::runtime_error{ "Boom" }; }
+        completed[index] = 1;
+    }), std::runtime_error);
+    CHECK(std::count(completed.begin(), completed.end(), 1) == 63);
+    pool.parallelFor(0, [](std::size_t) {});
+
+    // Nested calls from within a task run inline instead of deadlocking on the busy pool
+    auto nested = std::vector<int>(8 * 16);
+    pool.parallelFor(8, [&pool, &nested](std::size_t outer) {
+        pool.parallelFor(16, [&nested, outer](std::size_t inner) { nested[outer * 16 + inner] += 1; });
+    });
+    CHECK(std::all_of(nested.begin(), nested.end(), [](int hit) { return hit == 1; }));
+}
+
+TEST_CASE("Batch serialization matches record-by-record serialization") {
+    auto pool = WorkStealingPool{ 3 };
+    auto names = std::vector<std::string>{ };
+    for (auto i = 0; i < 2000; ++i) { names.push_back("record-" + std::to_string(i)); }
+    auto records = std::vector<FOO_OPTIONAL_BAR>{ };
+    for (auto i = 0; i < 2000; ++i) {
+        records.emplace_back(FOO{ i, names[i], '-' }, i % 3 == 0 ? std::optional<BAR>{ BAR{ -i, names[i], "" } } : std::nullopt);
+    }
+
+    auto expected = std::string{ };
+    for (const auto& record : records) { expected += record.serialize() + "\n"; }
+    const auto text = serializeBatch(records, pool);
+    CHECK(text == expected);
+
+    // Segments of the boundary scan start mid-record, including inside nested objects
+    auto decoded = std::vector<FOO_OPTIONAL_BAR>{ records[0] };
+    CHECK(deserializeBatch(text, decoded, pool) == records.size());
+    REQUIRE(decoded.size() == records.size() + 1);
+    CHECK(std::equal(records.begin(), records.end(), decoded.begin() + 1));
+
+    CHECK(serializeBatch(std::vector<FOO>{ }, pool).empty());
+    CHECK_THROWS_AS(deserializeBatch(text + "{\n\tone : 1", decoded, pool), std::runtime_error);
+    CHECK_THROWS_AS(deserializeBatch("oops" + text, decoded, pool), std::runtime_error);
+    CHECK(decoded.size() == records.size() + 1);
+}
+
+struct TICKET : public SERIALIZATION<TICKET>, LEXICOGRAPHICAL_EQUALITY<TICKET>, LEXICOGRAPHICAL_ORDERING<TICKET>, MEMBERWISE_HASH<TICKET> {
+    int id_{ 0 };
+    short gate_{ 0 };
+    short seat_{ 0 };
+    std::string_view holder_{};
+    char row_{ ' ' };
+    int price_{ 0 }; // Padding separates this from row_
+
+    constexpr TICKET() = default;
+
+    constexpr TICKET(int id, short gate, short seat, std::string_view holder, char row, int price) : id_{ id }, gate_{ gate }, seat_{ seat }, holder_{ holder }, row_{ row }, price_{ price } { }
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&TICKET::id_, "id"), MakeBinding(&TICKET::gate_, "gate"), MakeBinding(&TICKET::seat_, "seat"),
+            MakeBinding(&TICKET::holder_, "holder"), MakeBinding(&TICKET::row_, "row"), MakeBinding(&TICKET::price_, "price"));
+    }
+};
+
+struct WIDE_TICKET : public LEXICOGRAPHICAL_EQUALITY<WIDE_TICKET>, LEXICOGRAPHICAL_ORDERING<WIDE_TICKET>, MEMBERWISE_HASH<WIDE_TICKET> {
+    std::int64_t a_{ 0 }, b_{ 0 }, c_{ 0 }, d_{ 0 }, e_{ 0 }, f_{ 0 }, g_{ 0 }, h_{ 0 }, i_{ 0 };
+    std::string_view tag_{};
+    std::int64_t checksum_{ 0 };
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&WIDE_TICKET::a_, "a"), MakeBinding(&WIDE_TICKET::b_, "b"), MakeBinding(&WIDE_TICKET::c_, "c"),
+            MakeBinding(&WIDE_TICKET::d_, "d"), MakeBinding(&WIDE_TICKET::e_, "e"), MakeBinding(&WIDE_TICKET::f_, "f"), MakeBinding(&WIDE_TICKET::g_, "g"),
+            MakeBinding(&WIDE_TICKET::h_, "h"), MakeBinding(&WIDE_TICKET::i_, "i"), MakeBinding(&WIDE_TICKET::tag_, "tag"), MakeBinding(&WIDE_TICKET::checksum_, "checksum"));
+    }
+};
+
+TEST_CASE("Adjacent integral members are compared and hashed as one run") {
+    const auto layout = member_runs::LayoutOf(TICKET{ });
+    CHECK(layout.runBytes[0] == sizeof(int) + 2 * sizeof(short));
+    CHECK(layout.runEnd[0] == 3);
+    CHECK_FALSE(layout.inRun[3]); // std::string_view is compared by value
+    CHECK(layout.runBytes[4] == sizeof(char)); // Padding ends the run
+    CHECK(layout.runBytes[5] == sizeof(int));
+
+    // Padding bytes never take part, whatever they hold
+    alignas(TICKET) unsigned char lhsStorage[sizeof(TICKET)];
+    alignas(TICKET) unsigned char rhsStorage[sizeof(TICKET)];
+    std::memset(lhsStorage, 0x00, sizeof(TICKET));
+    std::memset(rhsStorage, 0xff, sizeof(TICKET));
+    const auto& lhs = *new (lhsStorage) TICKET{ 7, 1, 2, "ann", 'c', 40 };
+    const auto& rhs = *new (rhsStorage) TICKET{ 7, 1, 2, "ann", 'c', 40 };
+    CHECK(lhs == rhs);
+    CHECK(compare(lhs, rhs) == 0);
+    CHECK(lhs.hash() == rhs.hash());
+
+    // Ordering agrees with member by member comparison, including within runs
+    const auto tickets = std::array<TICKET, 8>{
+        TICKET{ 1, 1, 1, "ann", 'a', 10 }, TICKET{ 1, 1, 2, "ann", 'a', 10 }, TICKET{ 1, 2, -1, "ann", 'a', 10 }, TICKET{ -1, 9, 9, "zed", 'z', 99 },
+        TICKET{ 1, 1, 1, "bob", 'a', 10 }, TICKET{ 1, 1, 1, "ann", 'b', 10 }, TICKET{ 1, 1, 1, "ann", 'a', -10 }, TICKET{ 256, 0, 0, "", ' ', 0 } };
+    for (const auto& a : tickets) {
+        for (const auto& b : tickets) {
+            CHECK(compare(a, b) == member_runs::CompareMemberwise(a, b));
+            CHECK((a == b) == (compare(a, b) == 0));
+        }
+    }
+    STATIC_REQUIRE(TICKET{ 1, 1, 1, "ann", 'a', 10 } < TICKET{ 1, 1, 2, "ann", 'a', 10 });
+    STATIC_REQUIRE(TICKET{ 1, 1, 1, "bob", 'a', 10 } >= TICKET{ 1, 1, 1, "ann", 'z', 10 });
+
+    auto sorted = std::vector<TICKET>(tickets.begin(), tickets.end());
+    std::sort(sorted.begin(), sorted.end());
+    CHECK(std::is_sorted(sorted.begin(), sorted.end(), [](const TICKET& a, const TICKET& b) { return member_runs::CompareMemberwise(a, b) < 0; }));
+
+    // Equal objects hash equally, so mapped types can key unordered containers
+    auto unique = std::unordered_set<TICKET, MemberwiseHash>(tickets.begin(), tickets.end());
+    unique.insert(tickets.begin(), tickets.end());
+    CHECK(unique.size() == tickets.size());
+    // Long runs take the block comparison path
+    const auto wide = member_runs::LayoutOf(WIDE_TICKET{ });
+    CHECK(wide.runBytes[0] == 9 * sizeof(std::int64_t));
+    auto samples = std::vector<WIDE_TICKET>(6);
+    samples[1].h_ = -1;
+    samples[2].a_ = 1;
+    samples[3].tag_ = "x";
+    samples[4].checksum_ = 5;
+    samples[5].i_ = 1;
+    for (const auto& a : samples) {
+        for (const auto& b : samples) {
+            CHECK(compare(a, b) == member_runs::CompareMemberwise(a, b));
+            CHECK((a == b) == member_runs::EqualMemberwise(a, b));
+            CHECK((a == b) == (a.hash() == b.hash()));
+        }
+    }
+
+    const auto copiedText = std::string{ "abc" }; // Strings hash by content, not address
+    CHECK(MemberwiseHash{ }(FOO{ 1, "abc", '-' }) == MemberwiseHash{ }(FOO{ 1, copiedText, '-' }));
+    CHECK(member_runs::HashBytes("0123456789abcdef0123456789abcdef!", 33, 0) != member_runs::HashBytes("0123456789abcdef0123456789abcdeg!", 33, 0));
+}
+
+TEST_CASE("Constant objects serialize during compilation") {
+    static constexpr auto myFoo = FOO{ -1234, "abc", '-' };
+    STATIC_REQUIRE(serializedConstant<myFoo> == "{\n\tone : -1234,\n\ttwo : abc,\n\tthree : -\n}");
+    STATIC_REQUIRE(serializedArray<myFoo>.size() == myFoo.serializedSize());
+    CHECK(serializedConstant<myFoo> == myFoo.serialize());
+
+    // Nested, optional and container members, and the full range of int
+    static constexpr auto nested = FOO_OPTIONAL_BAR{ FOO{ std::numeric_limits<int>::min(), "x", '+' }, std::nullopt };
+    CHECK(serializedConstant<nested> == nested.serialize());
+    static constexpr auto myBox = BOX{ { 0, std::numeric_limits<int>::max(), -7 }, 'q' };
+    CHECK(serializedConstant<myBox> == myBox.serialize());
+
+    // Fixed-width types bound their own capacity; others name one
+    static constexpr auto fixed = myBox.serializeFixed();
+    STATIC_REQUIRE(fixed.capacity() == BOX::maxSerializedSize());
+    CHECK(fixed.view() == myBox.serialize());
+    STATIC_REQUIRE(serializeToFixedString<64>(myFoo).view() == serializedConstant<myFoo>);
+    CHECK_THROWS_AS(serializeToFixedString<8>(myFoo), std::length_error);
+    CHECK(BAZ{ }.serializeFixed().view() == "{\n}");
+}
+
+TEST_CASE("Deltas carry only changed fields and patch objects in place") {
+    const auto old = FOO{ 1, "abc", '-' };
+    auto now = old;
+    CHECK(diff(old, now) == "{\n}");
+    now.three_ = '+';
+    CHECK(diff(old, now) == "{\n\tthree : +\n}");
+
+    auto target = old;
+    applyPatch(target, diff(old, now));
+    CHECK(target == now);
+
+    // Nested objects are diffed rather than rewritten
+    const auto before = FOO_OPTIONAL_BAR{ FOO{ 1, "abc", '-' }, std::nullopt };
+    auto after = FOO_OPTIONAL_BAR{ FOO{ 1, "xyz", '-' }, std::nullopt };
+    CHECK(diff(before, after) == "{\n\tfoo : {\n\ttwo : xyz\n}\n}");
+
+    // Optionals that appear carry a delta against a default object; those that disappear carry an empty value
+    after.bar_ = BAR{ 0, "", "" };
+    const auto appeared = diff(before, after); // Patched objects view into their patch, so each one is kept alive
+    CHECK(appeared == "{\n\tfoo : {\n\ttwo : xyz\n},\n\tbar : {\n}\n}");
+    auto patched = before;
+    applyPatch(patched, appeared);
+    CHECK(patched == after);
+
+    after.bar_->one_ = 5;
+    const auto changed = diff(patched, after);
+    CHECK(changed == "{\n\tbar : {\n\tone : 5\n}\n}");
+    applyPatch(patched, changed);
+    CHECK(patched == after);
+
+    const auto disappeared = diff(after, before);
+    CHECK(disappeared == "{\n\tfoo : {\n\ttwo : abc\n},\n\tbar : \n}");
+    applyPatch(patched, disappeared);
+    CHECK(patched == before);
+
+    // Strings emptied and containers changed in place; untouched members stay as they were
+    auto stock = INVENTORY{ };
+    stock.items_ = { FOO{ 1, "a", 'x' } };
+    stock.tags_ = { 'a', 'b' };
+    auto restocked = stock;
+    restocked.items_[0].two_ = "";
+    restocked.tags_.erase('a');
+    const auto restock = diff(stock, restocked);
+    CHECK(restock.find("dimensions") == std::string::npos);
+    auto copy = stock;
+    applyPatch(copy, restock);
+    CHECK(copy == restocked);
+
+    // Keys outside the mapping are ignored; malformed deltas are rejected
+    applyPatch(target, "{\n\tunknown : 3\n}");
+    CHECK(target == now);
+    CHECK_THROWS_AS(applyPatch(target, "three : +"), std::runtime_error);
+    CHECK_THROWS_AS(applyPatch(patched, "{\n\tfoo : 1\n}"), std::runtime_error);
+}
+
+TEST_CASE("Serialized views decode only the fields asked for") {
+    static constexpr auto myFoo = FOO{ 42, "abc", '-' };
+    STATIC_REQUIRE([] {
+        auto view = SerializedView<FOO>{ serializedConstant<myFoo> };
+        return view.get<&FOO::three_>() == '-' && view.get<&FOO::one_>() == 42;
+    }());
+
+    const auto text = myFoo.serialize();
+    auto view = SerializedView<FOO>{ text };
+    CHECK(view.get<&FOO::one_>() == 42);
+    CHECK(view.get<&FOO::two_>() == "abc");
+    CHECK(view.get<&FOO::three_>() == '-');
+    CHECK(view.raw<&FOO::one_>() == "42");
+
+    // Nested objects are viewed without decoding them; empty optionals have nothing to view
+    const auto nested = FOO_OPTIONAL_BAR{ FOO{ 7, "xyz", '+' }, BAR{ 3, "bar", "" } }.serialize();
+    auto outer = SerializedView<FOO_OPTIONAL_BAR>{ nested };
+    CHECK(outer.view<&FOO_OPTIONAL_BAR::foo_>().get<&FOO::two_>() == "xyz");
+    REQUIRE(outer.view<&FOO_OPTIONAL_BAR::bar_>().has_value());
+    CHECK(outer.view<&FOO_OPTIONAL_BAR::bar_>()->get<&BAR::one_>() == 3);
+    CHECK(outer.get<&FOO_OPTIONAL_BAR::foo_>() == FOO{ 7, "xyz", '+' });
+
+    const auto absent = FOO_OPTIONAL_BAR{ FOO{ }, std::nullopt }.serialize();
+    auto empty = SerializedView<FOO_OPTIONAL_BAR>{ absent };
+    CHECK_FALSE(empty.has<&FOO_OPTIONAL_BAR::bar_>());
+    CHECK_FALSE(empty.view<&FOO_OPTIONAL_BAR::bar_>().has_value());
+    CHECK_FALSE(empty.get<&FOO_OPTIONAL_BAR::bar_>().has_value());
+
+    // Containers of nested objects
+    auto stock = INVENTORY{ };
+    for (auto i = 0; i < 20; ++i) { stock.items_.push_back(FOO{ i, "item", 'i' }); }
+    stock.dimensions_ = { 1, 2, 3 };
+    const auto stockText = stock.serialize();
+    auto stockView = SerializedView<INVENTORY>{ stockText };
+    CHECK(stockView.get<&INVENTORY::dimensions_>() == stock.dimensions_);
+    CHECK(stockView.get<&INVENTORY::items_>() == stock.items_);
+
+    // Repeated keys resolve to the first occurrence, whichever field is looked up first
+    const auto repeated = std::string_view{ "{\n\tone : 1,\n\ttwo : abc,\n\tone : 2,\n\tthree : -\n}" };
+    auto forward = SerializedView<FOO>{ repeated };
+    CHECK(forward.get<&FOO::one_>() == 1);
+    CHECK(forward.get<&FOO::three_>() == '-');
+    CHECK(forward.get<&FOO::one_>() == 1);
+    auto backward = SerializedView<FOO>{ repeated };
+    CHECK(backward.get<&FOO::three_>() == '-');
+    CHECK(backward.get<&FOO::one_>() == 1);
+
+    CHECK_THROWS_AS(SerializedView<FOO>{ "one : 1" }, std::runtime_error);
+}
+
+struct CATALOG : public SERIALIZATION<CATALOG>, LEXICOGRAPHICAL_EQUALITY<CATALOG> {
+    std::pmr::string title_{};
+    std::pmr::vector<std::pmr::string> tags_{};
+    std::pmr::map<std::pmr::string, int> stock_{};
+    std::optional<std::pmr::string> note_{};
+    FOO featured_{};
+    std::string owner_{};
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&CATALOG::title_, "title"), MakeBinding(&CATALOG::tags_, "tags"), MakeBinding(&CATALOG::stock_, "stock"),
+            MakeBinding(&CATALOG::note_, "note"), MakeBinding(&CATALOG::featured_, "featured"), MakeBinding(&CATALOG::owner_, "owner"));
+    }
+};
+
+TEST_CASE("Arena deserialization owns its strings, containers and nested objects") {
+    auto catalog = CATALOG{ };
+    catalog.title_ = "A title long enough to defeat the small string optimization";
+    catalog.tags_ = { "first tag well past the small string buffer", "second" };
+    catalog.stock_ = { { "apples of a rather long and descriptive name", 3 }, { "pears", 4 } };
+    catalog.note_ = "noted";
+    catalog.featured_ = FOO{ 5, "featured text", '*' };
+    catalog.owner_ = "owning std::string members are supported as well";
+
+    auto text = catalog.serialize();
+    CHECK(CATALOG::deserialize(text) == catalog);
+
+    // Every allocation must come from the buffer: the upstream resource refuses to allocate
+    alignas(std::max_align_t) std::byte buffer[4096];
+    auto pool = std::pmr::monotonic_buffer_resource{ buffer, sizeof(buffer), std::pmr::null_memory_resource() };
+    auto copies = std::vector<CATALOG>{ };
+    for (auto i = 0; i < 3; ++i) { copies.push_back(CATALOG::deserializeWith(text, &pool)); }
+    CHECK(copies[0].title_.get_allocator().resource() == &pool);
+    CHECK(copies[1].tags_.get_allocator().resource() == &pool);
+    CHECK(copies[1].tags_[0].get_allocator().resource() == &pool);
+    CHECK(copies[2].stock_.begin()->first.get_allocator().resource() == &pool);
+    CHECK(copies[2].note_->get_allocator().resource() == &pool);
+    CHECK(arena::CurrentResource() == nullptr);
+
+    // Views are copied into the arena, so the input buffer may be recycled
+    std::fill(text.begin(), text.end(), '#');
+    for (const auto& copy : copies) { CHECK(copy == catalog); }
+    CHECK_FALSE(copies[0].featured_.two_.data() == copies[1].featured_.two_.data());
+    CHECK_THROWS_AS(CATALOG::deserializeWith(catalog.serialize(), std::pmr::null_memory_resource()), std::bad_alloc);
+    CHECK(arena::CurrentResource() == nullptr);
+
+    copies.clear(); // Arena-backed objects must not outlive their arena
+    pool.release();
+
+    // Batches install the caller's arena on every worker: std::pmr members and escaped views land on it rather than the default resource
+    catalog.featured_.two_ = "featured, escaped";
+    auto batchText = std::string{ };
+    for (auto i = 0; i < 64; ++i) { batchText += catalog.serialize() + "\n"; }
+    auto storage = std::vector<std::byte>(1 << 18);
+    auto batchArena = std::pmr::monotonic_buffer_resource{ storage.data(), storage.size(), std::pmr::null_memory_resource() };
+    auto shared = arena::SynchronizedResource{ &batchArena };
+    auto workers = WorkStealingPool{ 4 };
+    auto batch = std::vector<CATALOG>{ };
+    {
+        const auto scope = arena::ScopedResource{ &shared };
+        CHECK(deserializeBatch(batchText, batch, workers) == 64);
+    }
+    REQUIRE(batch.size() == 64);
+    CHECK(std::all_of(batch.begin(), batch.end(), [&catalog](const CATALOG& copy) { return copy == catalog; }));
+    CHECK(std::all_of(batch.begin(), batch.end(), [&shared](const CATALOG& copy) { return copy.title_.get_allocator().resource() == &shared; }));
+    CHECK(std::all_of(batch.begin(), batch.end(), [&shared](const CATALOG& copy) { return copy.tags_[0].get_allocator().resource() == &shared; }));
+    std::fill(batchText.begin(), batchText.end(), '#');
+    CHECK(batch.back().featured_.two_ == "featured, escaped");
+    batch.clear();
+}
+
+struct MESSAGE : public SERIALIZATION<MESSAGE>, LEXICOGRAPHICAL_EQUALITY<MESSAGE> {
+    std::string body_{};
+    std::vector<int> values_{};
+    std::optional<std::string> note_{};
+    std::map<std::string, int> counts_{};
+    FOO header_{};
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&MESSAGE::body_, "body"), MakeBinding(&MESSAGE::values_, "values"), MakeBinding(&MESSAGE::note_, "note"),
+            MakeBinding(&MESSAGE::counts_, "counts"), MakeBinding(&MESSAGE::header_, "header"));
+    }
+};
+
+struct SPARSE_LISTS : public SERIALIZATION<SPARSE_LISTS>, LEXICOGRAPHICAL_EQUALITY<SPARSE_LISTS> {
+    std::vector<std::string> names_{};
+    std::vector<std::optional<int>> scores_{};
+
+    SPARSE_LISTS() = default;
+
+    SPARSE_LISTS(std::vector<std::string> names, std::vector<std::optional<int>> scores) : names_{ std::move(names) }, scores_{ std::move(scores) } { }
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&SPARSE_LISTS::names_, "names"), MakeBinding(&SPARSE_LISTS::scores_, "scores"));
+    }
+};
+
+TEST_CASE("deserializeInto reuses the storage of an existing object") {
+    auto first = MESSAGE{ };
+    first.body_ = "the first message body is longer than any small string buffer";
+    first.values_ = { 1, 2, 3, 4 };
+    first.note_ = "a note long enough to be allocated on the heap";
+    first.counts_ = { { "alpha key long enough to be allocated", 1 }, { "beta key long enough to be allocated", 2 } };
+    first.header_ = FOO{ 1, "head", 'h' };
+    auto second = MESSAGE{ };
+    second.body_ = "the second message body is shorter";
+    second.values_ = { 5, 6 };
+    second.note_ = "a second note that is also heap allocated";
+    second.counts_ = { { "gamma key long enough to be allocated", 3 }, { "delta key long enough to be allocated", 4 } };
+    second.header_ = FOO{ 2, "next", 'n' };
+    const auto firstText = first.serialize();
+    const auto secondText = second.serialize();
+
+    auto target = MESSAGE{ };
+    MESSAGE::deserializeInto(target, firstText);
+    CHECK(target == first);
+    CHECK(target == MESSAGE::deserialize(firstText));
+
+    const auto* body = target.body_.data();
+    const auto* values = target.values_.data();
+    const auto* note = target.note_->data();
+    const auto* entry = &*target.counts_.begin();
+    MESSAGE::deserializeInto(target, secondText);
+    CHECK(target == second);
+    CHECK(target.body_.data() == body);
+    CHECK(target.values_.data() == values);
+    CHECK(target.note_->data() == note);
+    CHECK(&*target.counts_.begin() == entry); // Map nodes are relinked rather than reallocated
+
+    // Null and absent fields clear the target, as they would a fresh object
+    MESSAGE::deserializeInto(target, "{\n\tbody : short,\n\tvalues : [0],\n\tcounts : [0],\n\theader : {\n\tone : 3,\n\tthree : z\n}\n}");
+    CHECK(target.body_ == "short");
+    CHECK(target.values_.empty());
+    CHECK_FALSE(target.note_.has_value());
+    CHECK(target.counts_.empty());
+    CHECK(target.header_ == FOO{ 3, "", 'z' });
+    CHECK_THROWS_AS(MESSAGE::deserializeInto(target, "{\n\tvalues : [1000000000 : 1]\n}"), std::runtime_error);
+
+    // Elements may serialize to nothing at all: empty strings and null optionals
+    for (const auto& lists : { SPARSE_LISTS{ { "" }, { std::nullopt } }, SPARSE_LISTS{ { "", "", "" }, { std::nullopt, 1, std::nullopt } } }) {
+        const auto listsText = lists.serialize();
+        CHECK(SPARSE_LISTS::deserialize(listsText) == lists);
+        auto reused = SPARSE_LISTS{ { "x", "y" }, { 2 } };
+        SPARSE_LISTS::deserializeInto(reused, listsText);
+        CHECK(reused == lists);
+    }
+    CHECK(SPARSE_LISTS{ { "" }, { } }.serialize().find("names : [1 : ]") != std::string::npos);
+
+    static constexpr auto boxText = std::string_view{ "{\n\tdimensions : [3 : 1, 2, 3],\n\tlabel : x\n}" };
+    STATIC_REQUIRE([] {
+        auto box = BOX{ };
+        BOX::deserializeInto(box, boxText);
+        return box.dimensions_[2] == 3 && box.label_ == 'x';
+    }());
+}
+
+template <class T> void CheckNumberRoundTrip(T value) {
+    char buffer[number::maxChars<T>]{ };
+    const auto* end = number::ToChars(std::begin(buffer), value);
+    const auto text = std::string_view{ buffer, static_cast<std::size_t>(end - buffer) };
+    if constexpr (number::isInteger<T>) {
+        CHECK(text == std::to_string(value));
+        CHECK(number::ToCharsLength(value) == text.size());
+    }
+    const auto parsed = number::FromChars<T>(text.data(), text.data() + text.size());
+    REQUIRE(parsed.has_value());
+    CHECK(*parsed == value);
+}
+
+template <class T> void CheckIntegerLimits() {
+    for (auto value : { std::numeric_limits<T>::min(), std::numeric_limits<T>::max(), T{ 0 }, T{ 1 }, T{ 9 }, T{ 10 }, T{ 99 }, T{ 100 } }) {
+        CheckNumberRoundTrip(value);
+    }
+    // One past either end of the range is rejected rather than wrapped
+    auto past = std::to_string(std::numeric_limits<T>::max());
+    past.back() += 1;
+    CHECK_FALSE(number::FromChars<T>(past.data(), past.data() + past.size()).has_value());
+    if constexpr (std::is_signed_v<T>) {
+        auto below = std::to_string(std::numeric_limits<T>::min());
+        below.back() += 1;
+        CHECK_FALSE(number::FromChars<T>(below.data(), below.data() + below.size()).has_value());
+    }
+}
+
+struct READING : public SERIALIZATION<READING>, LEXICOGRAPHICAL_EQUALITY<READING> {
+    std::int8_t level_{ 0 };
+    std::uint16_t channel_{ 0 };
+    long long timestamp_{ 0 };
+    unsigned long long counter_{ 0 };
+    bool valid_{ false };
+    float gain_{ 0 };
+    double value_{ 0 };
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&READING::level_, "level"), MakeBinding(&READING::channel_, "channel"), MakeBinding(&READING::timestamp_, "timestamp"),
+            MakeBinding(&READING::counter_, "counter"), MakeBinding(&READING::valid_, "valid"), MakeBinding(&READING::gain_, "gain"), MakeBinding(&READING::value_, "value"));
+    }
+};
+
+TEST_CASE("Number kernels cover every arithmetic type") {
+    CheckIntegerLimits<signed char>();
+    CheckIntegerLimits<unsigned char>();
+    CheckIntegerLimits<short>();
+    CheckIntegerLimits<unsigned short>();
+    CheckIntegerLimits<int>();
+    CheckIntegerLimits<unsigned>();
+    CheckIntegerLimits<long>();
+    CheckIntegerLimits<unsigned long>();
+    CheckIntegerLimits<long long>();
+    CheckIntegerLimits<unsigned long long>();
+    for (auto value = 1ULL; value < std::numeric_limits<unsigned long long>::max() / 7; value = value * 7 + 3) { CheckNumberRoundTrip(value); }
+
+    // Whole input must be one well-formed value; leading zeros do not count towards the digit limit
+    const auto parse = [](std::string_view text) { return number::FromChars<long long>(text.data(), text.data() + text.size()); };
+    CHECK_FALSE(parse("").has_value());
+    CHECK_FALSE(parse("-").has_value());
+    CHECK_FALSE(parse("12345678x").has_value());
+    CHECK_FALSE(parse("1234567890123456:").has_value());
+    CHECK_FALSE(parse("+1").has_value());
+    CHECK_FALSE(parse("99999999999999999999").has_value());
+    CHECK(parse("0000000000000000000000042") == 42);
+    CHECK(number::FromChars<unsigned long long>("18446744073709551615", "18446744073709551615" + 20) == std::numeric_limits<unsigned long long>::max());
+    CHECK_FALSE(number::FromChars<unsigned long long>("18446744073709551616", "18446744073709551616" + 20).has_value());
+    CHECK_FALSE(number::FromChars<unsigned>("-1", "-1" + 2).has_value());
+    STATIC_REQUIRE(number::FromChars<int>("-2147483648", "-2147483648" + 11) == std::numeric_limits<int>::min());
+    STATIC_REQUIRE(ToString(-1234567890123LL).view() == "-1234567890123");
+
+    CHECK(ToString(true).view() == "true");
+    CHECK(FromStringView<bool>("false") == false);
+    CHECK_THROWS_AS(FromStringView<bool>("1"), std::runtime_error);
+    CheckNumberRoundTrip(0.1);
+    CheckNumberRoundTrip(-std::numeric_limits<double>::max());
+    CheckNumberRoundTrip(std::numeric_limits<double>::denorm_min());
+    CheckNumberRoundTrip(1.17549435e-38f);
+    CheckNumberRoundTrip(-3.4028235e38f);
+    CHECK(ToString(0.1).view() == "0.1"); // Shortest form that reads back exactly
+
+    auto reading = READING{ };
+    reading.level_ = -128;
+    reading.channel_ = 65535;
+    reading.timestamp_ = std::numeric_limits<long long>::min();
+    reading.counter_ = std::numeric_limits<unsigned long long>::max();
+    reading.valid_ = true;
+    reading.gain_ = 0.5f;
+    reading.value_ = -1e-300;
+    const auto text = reading.serialize();
+    CHECK(text.size() == reading.serializedSize());
+    CHECK(READING::deserialize(text) == reading);
+    CHECK(text.find("\tlevel : -128,\n") != std::string::npos);
+    CHECK(text.find("\tvalid : true,\n") != std::string::npos);
+    CHECK_THROWS_AS(READING::deserialize("{\n\tlevel : 128\n}"), std::runtime_error);
+}
+
+struct TELEMETRY : public SERIALIZATION<TELEMETRY>, LEXICOGRAPHICAL_EQUALITY<TELEMETRY> {
+    int sequence_{ 0 };
+    std::optional<std::string_view> note_{ };
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&TELEMETRY::sequence_, "sequence"), MakeBinding(&TELEMETRY::note_, "note"));
+    }
+};
+
+struct TELEMETRY_ENVELOPE : public SERIALIZATION<TELEMETRY_ENVELOPE>, LEXICOGRAPHICAL_EQUALITY<TELEMETRY_ENVELOPE> {
+    TELEMETRY latest_{ };
+    std::vector<TELEMETRY> history_{ };
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&TELEMETRY_ENVELOPE::latest_, "latest"), MakeBinding(&TELEMETRY_ENVELOPE::history_, "history"));
+    }
+};
+
+class RecordingSink : public instrumentation::Sink {
+public:
+    void publish(const instrumentation::Statistics& statistics) override { types_.push_back(statistics.type); }
+
+    std::vector<std::string_view> types_;
+};
+
+TEST_CASE("Instrumentation counts calls, bytes, omitted nulls and unknown keys per type") {
+    STATIC_REQUIRE(serializable::traits::TypeName<TELEMETRY>() == "TELEMETRY");
+    STATIC_REQUIRE(instrumentation::BucketOf(0) == 0);
+    STATIC_REQUIRE(instrumentation::BucketOf(1) == 1);
+    STATIC_REQUIRE(instrumentation::BucketOf(1000) == 10);
+    static constexpr auto constant = TELEMETRY{ };
+    STATIC_REQUIRE(serializedConstant<constant> == "{\n\tsequence : 0\n}"); // Constant evaluation is never counted
+
+    // Counters only move when built with SERIAL_INSTRUMENTATION; otherwise every hook compiles away
+    const auto counted = instrumentation::enabled ? std::uint64_t{ 1 } : std::uint64_t{ 0 };
+    auto record = TELEMETRY{ };
+    record.sequence_ = 7;
+    const auto text = record.serialize();
+    auto buffer = std::string{ };
+    record.serializeInto(buffer);
+    CHECK(TELEMETRY::deserialize("{\n\tsequence : 7,\n\tunknown : 1,\n\tnote : hi\n}").note_ == "hi");
+    auto target = TELEMETRY{ };
+    TELEMETRY::deserializeInto(target, text);
+    CHECK_THROWS_AS(TELEMETRY::deserialize("{\n\tsequence : x\n}"), std::runtime_error);
+
+    const auto statistics = instrumentation::StatisticsOf<TELEMETRY>();
+    CHECK(statistics.serialize.calls == 2 * counted);
+    CHECK(statistics.serialize.bytes == 2 * text.size() * counted);
+    CHECK(statistics.serialize.failures == 0);
+    CHECK(statistics.deserialize.calls == 3 * counted);
+    CHECK(statistics.deserialize.failures == counted);
+    CHECK(statistics.nullFieldsOmitted == 2 * counted);
+    CHECK(statistics.unknownKeysSkipped == counted);
+    CHECK(instrumentation::Quantile(statistics.deserialize.latency, 0.99) >= instrumentation::Quantile(statistics.deserialize.latency, 0.5));
+
+    auto sink = RecordingSink{ };
+    instrumentation::Publish(sink);
+    CHECK(std::count(sink.types_.begin(), sink.types_.end(), "TELEMETRY") == 1); // Registered on first use, including by StatisticsOf()
+
+    instrumentation::Reset();
+    CHECK(instrumentation::StatisticsOf<TELEMETRY>().deserialize.calls == 0);
+
+    // Nested objects, alone or in containers, count towards the enclosing top-level call only
+    auto envelope = TELEMETRY_ENVELOPE{ };
+    envelope.latest_.sequence_ = 3;
+    envelope.history_.resize(2);
+    const auto envelopeText = envelope.serialize();
+    CHECK(TELEMETRY_ENVELOPE::deserialize(envelopeText) == envelope);
+    auto reused = TELEMETRY_ENVELOPE{ };
+    TELEMETRY_ENVELOPE::deserializeInto(reused, envelopeText);
+    CHECK(instrumentation::StatisticsOf<TELEMETRY>().serialize.calls == 0);
+    CHECK(instrumentation::StatisticsOf<TELEMETRY>().deserialize.calls == 0);
+    CHECK(instrumentation::StatisticsOf<TELEMETRY_ENVELOPE>().deserialize.calls == 2 * counted);
+    CHECK(instrumentation::StatisticsOf<TELEMETRY_ENVELOPE>().deserialize.bytes == 2 * envelopeText.size() * counted);
+    instrumentation::Reset();
+}
+
+TEST_CASE("Record log appends framed records and reads them back through a mapping") {
+    const auto path = (std::filesystem::temp_directory_path() / "serial_record_log_test.log").string();
+    const auto indexPath = record_log::IndexPath(path);
+    std::filesystem::remove(path);
+    std::filesystem::remove(indexPath);
+
+    auto names = std::vector<std::string>(120);
+    auto records = std::vector<FOO>(names.size());
+    for (auto i = std::size_t{ 0 }; i < names.size(); ++i) {
+        names[i] = "record " + std::to_string(i);
+        records[i] = FOO{ static_cast<int>(i), names[i], static_cast<char>('a' + i % 26) };
+    }
+
+    {
+        auto writer = RecordLogWriter<FOO>{ path };
+        for (auto i = 0; i < 100; ++i) { writer.append(records[i]); }
+        writer.flush();
+        CHECK(writer.size() == 100);
+    }
+    {
+        const auto reader = RecordLogReader<FOO>{ path };
+        REQUIRE(reader.size() == 100);
+        CHECK(reader.record(0) == records[0].serialize());
+        CHECK(reader.get(42) == records[42]);
+        const auto decoded = reader.get(7); // Views point into the mapping, not a copy
+        const auto text = reader.record(7);
+        CHECK(decoded.two_.data() >= text.data());
+        CHECK(decoded.two_.data() + decoded.two_.size() <= text.data() + text.size());
+
+        auto visited = std::vector<FOO>{ };
+        reader.forEach(90, 100, [&visited](const FOO& record) { visited.push_back(record); });
+        CHECK(visited == std::vector<FOO>(records.begin() + 90, records.begin() + 100));
+        auto bytes = std::size_t{ 0 };
+        reader.forEachRecord(0, reader.size(), [&bytes](std::string_view text) { bytes += text.size(); });
+        CHECK(bytes + 100 * record_log::lengthSize == std::filesystem::file_size(path));
+        CHECK_THROWS_AS(reader.record(100), std::out_of_range);
+        CHECK_THROWS_AS(reader.forEachRecord(50, 101, [](std::string_view) { }), std::out_of_range);
+    }
+
+    // Reopening appends after the existing records
+    {
+        auto writer = RecordLogWriter<FOO>{ path };
+        CHECK(writer.size() == 100);
+        for (auto i = 100; i < 110; ++i) { writer.append(records[i]); }
+    }
+    CHECK(RecordLogReader<FOO>{ path }.get(109) == records[109]);
+
+    // Crash: index behind the data, and a torn frame at the end
+    std::filesystem::resize_file(indexPath, 50 * record_log::offsetSize + 3);
+    {
+        auto data = std::ofstream{ path, std::ios::binary | std::ios::app };
+        data.write("\x10\x00\x00\x00{\n\t", 7);
+    }
+    {
+        const auto reader = RecordLogReader<FOO>{ path };
+        REQUIRE(reader.size() == 110);
+        CHECK(reader.get(49) == records[49]);
+        CHECK(reader.get(50) == records[50]);
+        CHECK(reader.get(109) == records[109]);
+    }
+    {
+        auto writer = RecordLogWriter<FOO>{ path };
+        CHECK(writer.size() == 110);
+        CHECK(std::filesystem::file_size(indexPath) == 110 * record_log::offsetSize);
+        for (auto i = 110; i < 120; ++i) { writer.append(records[i]); }
+    }
+    {
+        const auto reader = RecordLogReader<FOO>{ path };
+        REQUIRE(reader.size() == 120);
+        for (auto i = std::size_t{ 0 }; i < reader.size(); ++i) { CHECK(reader.get(i) == records[i]); }
+    }
+
+    // Without an index every frame is found by scanning
+    std::filesystem::remove(indexPath);
+    CHECK(RecordLogReader<FOO>{ path }.size() == 120);
+
+    // Crash: index grown but never written. Zero entries point at a valid frame, yet do not follow on from the entry before them
+    { auto writer = RecordLogWriter<FOO>{ path }; } // Rebuilds the index
+    REQUIRE(std::filesystem::file_size(indexPath) == 120 * record_log::offsetSize);
+    {
+        auto index = std::ofstream{ indexPath, std::ios::binary | std::ios::app };
+        index.write(std::string(2 * record_log::offsetSize, '\0').data(), 2 * record_log::offsetSize);
+    }
+    CHECK(RecordLogReader<FOO>{ path }.size() == 120);
+    {
+        auto writer = RecordLogWriter<FOO>{ path };
+        CHECK(writer.size() == 120);
+        writer.append(records[0]);
+    }
+    {
+        const auto reader = RecordLogReader<FOO>{ path };
+        REQUIRE(reader.size() == 121);
+        CHECK(reader.get(119) == records[119]);
+        CHECK(reader.get(120) == records[0]);
+    }
+
+    // A corrupt entry in the middle of the index throws when used instead of reading outside the mapping
+    {
+        auto index = std::fstream{ indexPath, std::ios::binary | std::ios::in | std::ios::out };
+        index.seekp(static_cast<std::streamoff>(record_log::offsetSize));
+        index.write("\xFF\xFF\xFF\xFF\xFF\xFF\x00\x00", record_log::offsetSize);
+    }
+    {
+        const auto reader = RecordLogReader<FOO>{ path };
+        REQUIRE(reader.size() == 121);
+        CHECK(reader.get(0) == records[0]);
+        CHECK_THROWS_AS(reader.record(1), std::runtime_error);
+        CHECK_THROWS_AS(reader.forEachRecord(1, 3, [](std::string_view) { }), std::runtime_error);
+        CHECK(reader.get(2) == records[2]);
+    }
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(indexPath);
+    CHECK_THROWS_AS(RecordLogReader<FOO>{ path }, std::runtime_error);
+}
+
+// Same members as FOO, mapped in another order, under another name, or with another type
+struct FOO_REORDERED : public SERIALIZATION<FOO_REORDERED>, LEXICOGRAPHICAL_EQUALITY<FOO_REORDERED> {
+    int one_{ 0 };
+    std::string_view two_;
+    char three_{ '\0' };
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&FOO_REORDERED::three_, "three"), MakeBinding(&FOO_REORDERED::one_, "one"), MakeBinding(&FOO_REORDERED::two_, "two"));
+    }
+};
+
+struct FOO_RENAMED : public SERIALIZATION<FOO_RENAMED> {
+    int one_{ 0 };
+    std::string_view two_;
+    char three_{ '\0' };
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&FOO_RENAMED::one_, "uno"), MakeBinding(&FOO_RENAMED::two_, "two"), MakeBinding(&FOO_RENAMED::three_, "three"));
+    }
+};
+
+struct FOO_RETYPED : public SERIALIZATION<FOO_RETYPED> {
+    long long one_{ 0 };
+    std::string_view two_;
+    char three_{ '\0' };
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&FOO_RETYPED::one_, "one"), MakeBinding(&FOO_RETYPED::two_, "two"), MakeBinding(&FOO_RETYPED::three_, "three"));
+    }
+};
+
+TEST_CASE("Schema fingerprints select positional decoding for matching readers") {
+    STATIC_REQUIRE(schemaFingerprint<FOO> != schemaFingerprint<FOO_REORDERED>);
+    STATIC_REQUIRE(schemaFingerprint<FOO> != schemaFingerprint<FOO_RENAMED>);
+    STATIC_REQUIRE(schemaFingerprint<FOO> != schemaFingerprint<FOO_RETYPED>);
+    STATIC_REQUIRE(schemaFingerprint<FOO_BAR> != schemaFingerprint<FOO_OPTIONAL_BAR>);
+    STATIC_REQUIRE(schemaFingerprint<FOO> == fingerprint::SchemaFingerprint<FOO>());
+
+    // Positional decoding works in constant expressions as well
+    static constexpr auto text = [] {
+        auto output = limited_constexpr::FixedString<128>{ };
+        serializeFingerprintedFromMetadata(output, FOO{ 1, "abc", '-' });
+        return output;
+    }();
+    STATIC_REQUIRE(FOO::deserialize(text.view()) == FOO{ 1, "abc", '-' });
+    CHECK(text.view() == "{" + std::string{ fingerprint::header<FOO> } + ",\n\tone : 1,\n\ttwo : abc,\n\tthree : -\n}");
+    CHECK(FOO{ 1, "abc", '-' }.serializeFingerprinted() == text.view());
+
+    // Null fields keep their place, with an empty value
+    const auto withoutBar = FOO_OPTIONAL_BAR{ FOO{ 2, "xyz", '+' }, std::nullopt };
+    const auto withBar = FOO_OPTIONAL_BAR{ FOO{ 3, "uvw", '*' }, BAR{ 4, "rst", "" } };
+    CHECK(withoutBar.serializeFingerprinted().find("\tbar : \n}") != std::string::npos);
+    CHECK(FOO_OPTIONAL_BAR::deserialize(withoutBar.serializeFingerprinted()) == withoutBar);
+    CHECK(FOO_OPTIONAL_BAR::deserialize(withBar.serializeFingerprinted()) == withBar);
+    auto target = withBar;
+    const auto withoutBarText = withoutBar.serializeFingerprinted(); // Outlives the views decoded from it
+    FOO_OPTIONAL_BAR::deserializeInto(target, withoutBarText);
+    CHECK(target == withoutBar);
+
+    // Readers of another schema skip the header and match keys as before
+    const auto reordered = FOO_REORDERED::deserialize(text.view());
+    CHECK(reordered.one_ == 1);
+    CHECK(reordered.two_ == "abc");
+    CHECK(reordered.three_ == '-');
+    CHECK(FOO::deserialize(FOO_REORDERED{ { }, { }, 5, "def", '!' }.serializeFingerprinted()) == FOO{ 5, "def", '!' });
+    CHECK(SerializedView<FOO>{ text.view() }.get<&FOO::two_>() == "abc");
+
+    // A matching header promises the layout: fields out of place are an error rather than silently misread
+    auto broken = std::string{ text.view() };
+    broken.replace(broken.find("one"), 3, "count");
+    CHECK_THROWS_AS(FOO::deserialize(broken), std::runtime_error);
+    CHECK_THROWS_AS(FOO::deserialize("{" + std::string{ fingerprint::header<FOO> } + ",\n\tone : 1\n}"), std::runtime_error);
+    auto swapped = std::string{ text.view() }; // A different key of the same length
+    swapped.replace(swapped.find("one"), 3, "two");
+    CHECK_THROWS_AS(FOO::deserialize(swapped), std::runtime_error);
+    auto trailing = std::string{ text.view() };
+    trailing.insert(trailing.size() - 2, ",\n\textra : 1");
+    CHECK_THROWS_AS(FOO::deserialize(trailing), std::runtime_error);
+
+    // Stream readers pick up the positional path too
+    auto records = std::vector<FOO>{ };
+    auto parser = MakeStreamDeserializer<FOO>([&records](const FOO& record) { records.push_back(record); });
+    const auto streamText = std::string{ text.view() } + "\n" + std::string{ text.view() }; // Outlives the records viewing it
+    parser.feed(streamText);
+    CHECK(records == std::vector<FOO>{ FOO{ 1, "abc", '-' }, FOO{ 1, "abc", '-' } });
+}
+
+TEST_CASE("tryDeserialize reports an error code and offset instead of throwing") {
+    // Well-formed input decodes as with deserialize()
+    STATIC_REQUIRE(tryDeserialize<FOO>("{\n\tone : 1,\n\ttwo : abc,\n\tthree : -\n}").value() == FOO{ 1, "abc", '-' });
+    const auto inventory = INVENTORY{ { FOO{ 1, "a", 'b' } }, { 1, 2, 3 }, { 'x', 'y' }, { { "k", 4 } }, { { 5, 6 }, { } } };
+    const auto inventoryText = inventory.serialize(); // Outlives the views decoded from it
+    const auto decoded = tryDeserialize<INVENTORY>(inventoryText);
+    REQUIRE(decoded.has_value());
+    CHECK(*decoded == inventory);
+    CHECK(decoded.error() == DeserializeError::none);
+    const auto sparse = SPARSE_LISTS{ { "" }, { std::nullopt } }; // Elements serialized as nothing at all
+    const auto sparseText = sparse.serialize();
+    const auto sparseDecoded = tryDeserialize<SPARSE_LISTS>(sparseText);
+    REQUIRE(sparseDecoded.has_value());
+    CHECK(*sparseDecoded == sparse);
+    CHECK(tryDeserialize<SPARSE_LISTS>("{\n\tnames : [3 : ]\n}").error() == DeserializeError::elementCount);
+    auto message = MESSAGE{ };
+    message.body_ = "hello";
+    message.values_ = { 1, 2 };
+    message.counts_ = { { "a", 1 } };
+    message.header_ = FOO{ 2, "b", 'c' };
+    CHECK(tryDeserialize<MESSAGE>(message.serialize()).value() == message);
+    CHECK(tryDeserialize<FOO>(FOO{ 3, "def", '!' }.serializeFingerprinted()).value() == FOO{ 3, "def", '!' }); // Header skipped as an unknown key
+
+    // Failures are found in constant expressions too, so reporting them cannot allocate
+    STATIC_REQUIRE(tryDeserialize<FOO>("").error() == DeserializeError::malformedObject);
+    STATIC_REQUIRE(tryDeserialize<FOO>("{\n\tone : x\n}").error() == DeserializeError::invalidNumber);
+    STATIC_REQUIRE(tryDeserialize<FOO>("{\n\tone : x\n}").offset() == 9);
+
+    // Hostile input: each failure names its cause and where it was found
+    auto Failure = [](const auto& result) { return std::make_pair(result.error(), result.offset()); };
+    using Error = DeserializeError;
+    CHECK(Failure(tryDeserialize<FOO>("{\n\tone : 1")) == std::make_pair(Error::malformedObject, std::size_t{ 0 }));
+    CHECK(Failure(tryDeserialize<FOO>("{\n\tone :1\n}")) == std::make_pair(Error::malformedField, std::size_t{ 3 }));
+    CHECK(Failure(tryDeserialize<FOO>("{\n\tone: 1\n}")) == std::make_pair(Error::malformedField, std::size_t{ 3 }));
+    CHECK(Failure(tryDeserialize<FOO>("{\n\tone : 1,\n\ttwo\n}")) == std::make_pair(Error::malformedField, std::size_t{ 13 }));
+    CHECK(Failure(tryDeserialize<FOO>("{\n\tone : 99999999999\n}")) == std::make_pair(Error::invalidNumber, std::size_t{ 9 }));
+    CHECK(Failure(tryDeserialize<FOO>("{\n\tthree : \n}")) == std::make_pair(Error::invalidCharacter, std::size_t{ 11 }));
+    CHECK(Failure(tryDeserialize<FOO>("{\n\tthree : ab\n}")) == std::make_pair(Error::invalidCharacter, std::size_t{ 11 }));
+    CHECK(Failure(tryDeserialize<INVENTORY>("{\n\tdimensions : 3 : 1\n}")) == std::make_pair(Error::malformedContainer, std::size_t{ 16 }));
+    CHECK(Failure(tryDeserialize<INVENTORY>("{\n\tdimensions : [2 : 1, 2]\n}")) == std::make_pair(Error::elementCount, std::size_t{ 16 }));
+    CHECK(Failure(tryDeserialize<INVENTORY>("{\n\titems : [1000000000 : ]\n}")).first == Error::elementCount); // No allocation for a corrupt count
+    const auto shortGrid = std::string{ "{\n\tgrid : [2 : [1 : 1]]\n}" };
+    CHECK(Failure(tryDeserialize<INVENTORY>(shortGrid)) == std::make_pair(Error::elementCount, shortGrid.find("]]") + 1));
+    const auto longGrid = std::string{ "{\n\tgrid : [1 : [1 : 1], [0]]\n}" };
+    CHECK(Failure(tryDeserialize<INVENTORY>(longGrid)) == std::make_pair(Error::elementCount, longGrid.find(" [0]")));
+    const auto nested = std::string{ "{\n\titems : [1 : {\n\tone : z\n}]\n}" };
+    CHECK(Failure(tryDeserialize<INVENTORY>(nested)) == std::make_pair(Error::invalidNumber, nested.find('z')));
+    CHECK(Failure(tryDeserialize<INVENTORY>("{\n\tcounts : [1 : k]\n}")) == std::make_pair(Error::malformedContainer, std::size_t{ 17 }));
+    CHECK(Describe(Error::elementCount) == "container elements do not match their count");
+
+    // Long bodies take the vectorized scanner and report the same offsets
+    auto padded = std::string{ "{\n\tbody : " } + std::string(100, 'x') + ",\n\tvalues : [1 : q]\n}";
+    CHECK(Failure(tryDeserialize<MESSAGE>(padded)) == std::make_pair(Error::invalidNumber, padded.find('q')));
+
+    // Absent fields keep their defaults unless every non-optional field is required
+    CHECK(tryDeserialize<FOO>("{\n\tone : 1\n}").value() == FOO{ 1, "", '\0' });
+    const auto strict = checked::Options{ true };
+    CHECK(Failure(tryDeserialize<FOO>("{\n\tone : 1\n}", strict)) == std::make_pair(Error::missingField, std::size_t{ 11 }));
+    CHECK(tryDeserialize<FOO>("{\n\tone : 1,\n\ttwo : ,\n\tthree : c\n}", strict).has_value());
+    const auto withoutBar = FOO_OPTIONAL_BAR{ FOO{ 2, "xyz", '+' }, std::nullopt };
+    CHECK(tryDeserialize<FOO_OPTIONAL_BAR>(withoutBar.serialize(), strict).value() == withoutBar);
+}
+
+TEST_CASE("Text values holding delimiters are escaped and unescaped") {
+    // Delimiters, whitespace and backslashes become two-character escapes; spaces only at either end of a value
+    STATIC_REQUIRE(serializeToFixedString<64>(FOO{ 1, "a,b", ':' }).view() == "{\n\tone : 1,\n\ttwo : a\\;b,\n\tthree : \\=\n}");
+    STATIC_REQUIRE(serializeToFixedString<64>(FOO{ 1, " a b ", ' ' }).view() == "{\n\tone : 1,\n\ttwo : \\_a b\\_,\n\tthree : \\_\n}");
+    STATIC_REQUIRE(FOO::deserialize("{\n\tone : 1,\n\tthree : \\\\\n}") == FOO{ 1, "", '\\' });
+
+    auto message = MESSAGE{ };
+    message.body_ = "{nested}, [bracketed]: line\nnext\tcolumn\r\\end";
+    message.values_ = { 1, 2 };
+    message.note_ = " padded note ";
+    message.counts_ = { { " a : b ", 1 }, { "c,d", 2 }, { "plain", 3 } };
+    message.header_ = FOO{ 2, "view", ',' };
+    const auto text = message.serialize();
+    CHECK(text.find("\\(nested\\)\\; \\<bracketed\\>\\= line\\nnext\\tcolumn\\r\\\\end") != std::string::npos);
+    CHECK(text.size() == message.serializedSize());
+    CHECK(MESSAGE::deserialize(text) == message);
+    CHECK(tryDeserialize<MESSAGE>(text).value() == message);
+    auto target = MESSAGE{ };
+    target.body_ = std::string(100, 'x');
+    MESSAGE::deserializeInto(target, text);
+    CHECK(target == message);
+
+    // Record boundaries are found by brace depth, which escaped braces no longer disturb
+    auto records = std::vector<MESSAGE>{ };
+    auto parser = MakeStreamDeserializer<MESSAGE>([&records](const MESSAGE& record) { records.push_back(record); });
+    const auto streamText = text + "\n" + text; // Outlives the records viewing it
+    parser.feed(streamText);
+    CHECK(records == std::vector<MESSAGE>{ message, message });
+
+    // Chars and container elements, whose surrounding spaces used to be trimmed
+    const auto inventory = INVENTORY{ { FOO{ 3, "x", ' ' } }, { 1, 2, 3 }, { ' ', ',', '}' }, { { "k", 4 } }, { } };
+    CHECK(INVENTORY::deserialize(inventory.serialize()) == inventory);
+
+    // Unescaped views keep referring into the input; escaped ones need an arena to be unescaped into
+    auto Failure = [](const auto& result) { return std::make_pair(result.error(), result.offset()); };
+    const auto plain = FOO{ 1, "plain text", '-' }.serialize();
+    const auto viewed = FOO::deserialize(plain);
+    CHECK(viewed.two_.data() >= plain.data());
+    CHECK(viewed.two_.data() < plain.data() + plain.size());
+    const auto escaped = FOO{ 1, "a,b", '-' }.serialize();
+    CHECK_THROWS_AS(FOO::deserialize(escaped), std::runtime_error);
+    CHECK(Failure(tryDeserialize<FOO>(escaped)) == std::make_pair(DeserializeError::invalidEscape, escaped.find("a\\;b")));
+    alignas(std::max_align_t) std::byte buffer[256];
+    auto pool = std::pmr::monotonic_buffer_resource{ buffer, sizeof(buffer), std::pmr::null_memory_resource() };
+    CHECK(FOO::deserializeWith(escaped, &pool).two_ == "a,b");
+
+    // Malformed sequences: a trailing marker or an unknown code
+    CHECK_THROWS_AS(MESSAGE::deserialize("{\n\tbody : abc\\\n}"), std::runtime_error);
+    CHECK_THROWS_AS(MESSAGE::deserialize("{\n\tbody : a\\qc\n}"), std::runtime_error);
+    CHECK_THROWS_AS(FOO::deserialize("{\n\tthree : \\q\n}"), std::runtime_error);
+    CHECK(tryDeserialize<MESSAGE>("{\n\tbody : a\\qc\n}").error() == DeserializeError::invalidEscape);
+
+    // The vectorized search agrees with the scalar one at every position, across block boundaries and in the tail
+    for (auto special : { ',', '\n', '\\', ']' }) {
+        for (auto i = std::size_t{ 0 }; i < 100; ++i) {
+            auto value = std::string(100, 'x');
+            value[i] = special;
+            CHECK(escape::FindSpecial(value, 0) == i);
+            CHECK(escape::FindSpecial(value, i + 1) == value.size());
+            CHECK(escape::EscapedSize(value) == 101);
+        }
+    }
+}
+
+enum class LEVEL : unsigned char { LOW, MEDIUM, HIGH };
+
+struct SAMPLE : public SERIALIZATION<SAMPLE>, LEXICOGRAPHICAL_EQUALITY<SAMPLE> {
+    long long timestamp_{ 0 };
+    int drift_{ 0 };
+    unsigned long long counter_{ 0 };
+    LEVEL level_{ LEVEL::LOW };
+    bool valid_{ false };
+    char grade_{ 'A' };
+    std::string_view site_{};
+    std::string comment_{};
+    std::optional<int> reading_{};
+    std::optional<std::string_view> tag_{};
+    double value_{ 0 };
+    FOO origin_{};
+    std::vector<int> history_{};
+
+    static constexpr auto DefineMemberMapping() {
+        return std::make_tuple(MakeBinding(&SAMPLE::timestamp_, "timestamp"), MakeBinding(&SAMPLE::drift_, "drift"), MakeBinding(&SAMPLE::counter_, "counter"),
+            MakeBinding(&SAMPLE::level_, "level"), MakeBinding(&SAMPLE::valid_, "valid"), MakeBinding(&SAMPLE::grade_, "grade"), MakeBinding(&SAMPLE::site_, "site"),
+            MakeBinding(&SAMPLE::comment_, "comment"), MakeBinding(&SAMPLE::reading_, "reading"), MakeBinding(&SAMPLE::tag_, "tag"), MakeBinding(&SAMPLE::value_, "value"),
+            MakeBinding(&SAMPLE::origin_, "origin"), MakeBinding(&SAMPLE::history_, "history"));
+    }
+};
+
+TEST_CASE("Columnar batches transpose records into encoded columns") {
+    constexpr std::string_view sites[] = { "north", "south", "east" };
+    auto records = std::vector<SAMPLE>(1000);
+    for (auto i = 0; i < static_cast<int>(records.size()); ++i) {
+        auto& record = records[static_cast<std::size_t>(i)];
+        record.timestamp_ = 1700000000000LL + 10 * i;
+        record.drift_ = i % 7 - 3;
+        record.counter_ = static_cast<unsigned long long>(i);
+        record.level_ = static_cast<LEVEL>(i % 3);
+        record.valid_ = i % 5 != 0;
+        record.grade_ = "ABCD"[i % 4];
+        record.site_ = sites[i % 3];
+        if (i % 100 == 0) { record.comment_ = "note " + std::to_string(i); }
+        if (i % 4 == 0) { record.reading_ = -i; }
+        if (i % 10 == 0) { record.tag_ = "tagged"; }
+        record.value_ = i * 0.5;
+        record.origin_ = FOO{ i, sites[(i + 1) % 3], 'x' };
+        if (i % 50 == 0) { record.history_ = { i, i + 1 }; }
+    }
+    // Extremes wrap through the differences and back
+    records[1].timestamp_ = std::numeric_limits<long long>::min();
+    records[2].timestamp_ = std::numeric_limits<long long>::max();
+    records[3].counter_ = std::numeric_limits<unsigned long long>::max();
+
+    const auto columns = serializeColumnar(records);
+    auto decoded = std::vector<SAMPLE>(1); // Appended to
+    CHECK(deserializeColumnar(columns, decoded) == records.size());
+    REQUIRE(decoded.size() == records.size() + 1);
+    CHECK(std::equal(records.begin(), records.end(), decoded.begin() + 1));
+    CHECK(decoded[1].site_.data() >= columns.data()); // Views point into the dictionary
+    CHECK(decoded[1].site_.data() < columns.data() + columns.size());
+    CHECK(columns.size() * 8 < serializeBatch(records).size());
+
+    // A single column is decoded without touching the others
+    auto timestamps = std::vector<long long>{ };
+    scanColumn<&SAMPLE::timestamp_>(columns, [&timestamps](long long timestamp) { timestamps.push_back(timestamp); });
+    CHECK(timestamps.size() == records.size());
+    CHECK(timestamps[2] == std::numeric_limits<long long>::max());
+    CHECK(timestamps.back() == records.back().timestamp_);
+    auto north = 0;
+    scanColumn<&SAMPLE::site_>(columns, [&north](std::string_view site) { north += site == "north"; });
+    CHECK(north == 334);
+    auto readings = 0LL;
+    auto rows = 0;
+    scanColumn<&SAMPLE::reading_>(columns, [&readings, &rows](const std::optional<int>& reading) {
+        readings += reading.value_or(0);
+        ++rows;
+    });
+    CHECK(rows == 1000);
+    CHECK(readings == -124500);
+    auto origins = 0LL;
+    scanColumn<&SAMPLE::origin_>(columns, [&origins](const FOO& origin) { origins += origin.one_; });
+    CHECK(origins == 499500);
+
+    // Sorted integers take a byte per row, and a three-entry dictionary two bits
+    const auto Single = [](long long timestamp, std::string_view site) {
+        auto record = SAMPLE{ };
+        record.timestamp_ = timestamp;
+        record.site_ = site;
+        return record;
+    };
+    auto sorted = std::vector<SAMPLE>{ };
+    for (auto i = 0; i < 800; ++i) { sorted.push_back(Single(1700000000000LL + i, sites[i % 3])); }
+    CHECK(serializeColumnar(sorted).size() < serializeColumnar(std::vector<SAMPLE>(800)).size() + 100 + 32); // vs. all-zero, all-empty rows at one bit each
+
+    // Empty batches, schema mismatches and damaged input
+    CHECK(deserializeColumnar(serializeColumnar(std::vector<SAMPLE>{ }), decoded) == 0);
+    auto foos = std::vector<FOO>{ };
+    CHECK_THROWS_AS(deserializeColumnar(columns, foos), std::runtime_error);
+    CHECK_THROWS_AS(deserializeColumnar(std::string_view{ columns }.substr(0, columns.size() - 1), decoded), std::runtime_error);
+    CHECK_THROWS_AS(deserializeColumnar(columns + '\0', decoded), std::runtime_error);
+    CHECK(decoded.size() == records.size() + 1);
+
+    // A forged row count is rejected by the input it claims before any row is allocated
+    STATIC_REQUIRE(columnar::MinRowBits<FOO>() == 8 + 1 + 1);
+    auto forged = serializeColumnar(std::vector<FOO>(1));
+    binary::StoreLittleEndian(&forged[sizeof(std::uint64_t)], columnar::RowCount{ 1 } << 31);
+    CHECK_THROWS_AS(deserializeColumnar(forged, foos), std::runtime_error);
+    CHECK_THROWS_AS(scanColumn<&FOO::one_>(forged, [](int) {}), std::runtime_error);
+    CHECK(foos.empty());
+}